@@ -12,6 +12,22 @@
                 'src/font.cc',
                 'src/book_holder.cc',
                 'src/string_copy.cc',
+                'src/utf8_value.cc',
+                'src/string_cache.cc',
+                'src/keys.cc',
+                'src/options.cc',
+                'src/style_spec.cc',
+                'src/style_registry.cc',
+                'src/style_snapshot.cc',
+                'src/cell_address.cc',
+                'src/cell_range.cc',
+                'src/value_format.cc',
+                'src/number_format.cc',
+                'src/csv.cc',
+                'src/records.cc',
+                'src/dump.cc',
+                'src/arrow_ipc.cc',
+                'src/column_batch.cc',
                 'src/buffer_copy.cc',
                 'src/core_properties.cc',
                 'src/rich_string.cc',
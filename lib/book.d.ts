@@ -1,11 +1,76 @@
 /// <reference types="node" />
 import { Sheet } from './sheet';
-import { Format } from './format';
+import { Format, FormatSpec, FontSpec } from './format';
 import { Font } from './font';
 import { RichString } from './rich_string';
 import { CoreProperties } from './core_properties';
 import { ConditionalFormat } from './conditional_format';
 
+export interface StyleSnapshot {
+    formats: {
+        font: Int32Array;
+        numFormat: Int32Array;
+        alignH: Int32Array;
+        alignV: Int32Array;
+        wrap: Uint8Array;
+        rotation: Int32Array;
+        indent: Int32Array;
+        shrinkToFit: Uint8Array;
+        borderLeft: Int32Array;
+        borderRight: Int32Array;
+        borderTop: Int32Array;
+        borderBottom: Int32Array;
+        borderLeftColor: Int32Array;
+        borderRightColor: Int32Array;
+        borderTopColor: Int32Array;
+        borderBottomColor: Int32Array;
+        borderDiagonal: Int32Array;
+        borderDiagonalColor: Int32Array;
+        fillPattern: Int32Array;
+        patternBackgroundColor: Int32Array;
+        patternForegroundColor: Int32Array;
+        locked: Uint8Array;
+        hidden: Uint8Array;
+    };
+    fonts: {
+        name: string[];
+        size: Int32Array;
+        italic: Uint8Array;
+        strikeOut: Uint8Array;
+        color: Int32Array;
+        bold: Uint8Array;
+        script: Int32Array;
+        underline: Int32Array;
+    };
+}
+
+export interface PictureBatch {
+    data: Buffer;
+    offsets: Uint32Array;
+    sizes: Uint32Array;
+    types: Int32Array;
+}
+
+export interface DumpOptions {
+    formulas?: boolean;
+    merges?: boolean;
+    dates?: 'iso' | 'epoch';
+}
+
+export type DumpValue = number | string | boolean | null;
+
+// Shape of the JSON produced by book.dumpAsync. Quadruples are [rowFirst, rowLast, colFirst, colLast].
+export interface BookDump {
+    sheets: {
+        name: string;
+        type: number;
+        hidden: number;
+        range: [number, number, number, number] | null;
+        merges: [number, number, number, number][];
+        cells: ([number, number, DumpValue] | [number, number, DumpValue, string])[];
+    }[];
+}
+
 export class Book {
     constructor(type: number);
 
@@ -204,9 +269,12 @@ export class Book {
     moveSheet(srcIndex: number, destIndex: number): Book;
     delSheet(index: number): Book;
     sheetCount(): number;
+    dumpAsync(callback: (err: Error | null, json: Buffer) => void): Book;
+    dumpAsync(options: DumpOptions | undefined, callback: (err: Error | null, json: Buffer) => void): Book;
 
     // Format management
-    addFormat(parentFormat?: Format): Format;
+    addFormat(parentFormat?: Format, spec?: FormatSpec): Format;
+    addFormat(spec: FormatSpec): Format;
     addFormatFromStyle(style: number): Format;
     format(index: number): Format;
     formatSize(): number;
@@ -247,10 +315,14 @@ export class Book {
         second: number;
         msecond: number;
     };
+    packDates(epochMs: Float64Array, out?: Float64Array): Float64Array;
+    unpackDates(values: Float64Array, out?: Float64Array): Float64Array;
 
     // Color utilities
     colorPack(red: number, green: number, blue: number): number;
     colorUnpack(value: number): { red: number; green: number; blue: number };
+    packColors(rgb: Uint8Array, out?: Int32Array): Int32Array;
+    unpackColors(colors: Int32Array, out?: Uint8Array): Uint8Array;
 
     // Active sheet
     activeSheet(): number;
@@ -261,6 +333,11 @@ export class Book {
     getPicture(index: number): { type: number; data: Buffer };
     getPictureSync(index: number): { type: number; data: Buffer };
     getPictureAsync(index: number, callback: (err: Error | null, type: number, data: Buffer) => void): Book;
+    getPicturesAsync(callback: (err: Error | null, pictures?: PictureBatch) => void): Book;
+    getPicturesAsync(
+        indices: Array<number> | Int32Array | undefined,
+        callback: (err: Error | null, pictures?: PictureBatch) => void,
+    ): Book;
     addPicture(filename: string): number;
     addPicture(buffer: Buffer): number;
     addPictureSync(filename: string): number;
@@ -325,4 +402,15 @@ export class Book {
 
     // Clear
     clear(): Book;
+
+    // Read string cache
+    setStringCacheSize(size: number): Book;
+    stringCacheStats(): { capacity: number; size: number; hits: number; misses: number };
+
+    // Write string dictionary
+    internString(value: string): number;
+    clearInternedStrings(): Book;
+    formatFor(spec: FormatSpec): Format;
+    fontFor(spec: FontSpec): Font;
+    styleSnapshot(): StyleSnapshot;
 }
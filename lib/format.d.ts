@@ -1,5 +1,44 @@
 import { Font } from './font';
 
+export interface FontSpec {
+    name?: string;
+    size?: number;
+    italic?: boolean;
+    strikeOut?: boolean;
+    color?: number;
+    bold?: boolean;
+    script?: number;
+    underline?: number;
+}
+
+export interface FormatSpec {
+    font?: Font | FontSpec;
+    numFormat?: number | string;
+    alignH?: number;
+    alignV?: number;
+    wrap?: boolean;
+    rotation?: number;
+    indent?: number;
+    shrinkToFit?: boolean;
+    border?: number;
+    borderColor?: number;
+    borderLeft?: number;
+    borderRight?: number;
+    borderTop?: number;
+    borderBottom?: number;
+    borderLeftColor?: number;
+    borderRightColor?: number;
+    borderTopColor?: number;
+    borderBottomColor?: number;
+    borderDiagonal?: number;
+    borderDiagonalColor?: number;
+    fillPattern?: number;
+    patternBackgroundColor?: number;
+    patternForegroundColor?: number;
+    locked?: boolean;
+    hidden?: boolean;
+}
+
 export class Format {
     font(): Font;
     setFont(font: Font): Format;
@@ -52,4 +91,5 @@ export class Format {
     setLocked(locked?: boolean): Format;
     hidden(): boolean;
     setHidden(hidden?: boolean): Format;
+    set(spec: FormatSpec): Format;
 }
@@ -1,6 +1,17 @@
-export { Book } from './book';
-export { Sheet } from './sheet';
-export { Format } from './format';
+export { Book, PictureBatch, StyleSnapshot, DumpOptions, BookDump } from './book';
+export {
+    Sheet,
+    CellValue,
+    CellRange,
+    CsvExportOptions,
+    CsvImportOptions,
+    RecordsOptions,
+    ArrowColumn,
+    RowWriterOptions,
+    BatchValue,
+    AddressBatch,
+} from './sheet';
+export { Format, FormatSpec, FontSpec } from './format';
 export { Font } from './font';
 export { CoreProperties } from './core_properties';
 export { RichString } from './rich_string';
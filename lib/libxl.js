@@ -23,4 +23,10 @@ if (!bindings) {
     throw new Error('unable to load libxl.node');
 }
 
+var RowWriter = require('./row_writer');
+
+bindings.Sheet.prototype.createRowWriter = function (options) {
+    return new RowWriter(this, options);
+};
+
 module.exports = bindings;
@@ -0,0 +1,110 @@
+var stream = require('stream');
+
+// Object mode stream that appends rows to a sheet. Rows are collected column by column and
+// written in batches by sheet.writeColumnsAsync; the stream does not accept more rows while a
+// batch is being written, so memory stays bounded by batchSize and the high water mark.
+class RowWriter extends stream.Writable {
+    constructor(sheet, options) {
+        options = options || {};
+
+        super({ objectMode: true, highWaterMark: options.highWaterMark });
+
+        this.sheet = sheet;
+        this.row = options.startRow === undefined ? sheet.lastRow() : options.startRow;
+        this.col = options.startCol || 0;
+        this.keys = options.columns;
+        this.formats = options.formats;
+        this.batchSize = options.batchSize || 1000;
+
+        this.columns = [];
+        this.count = 0;
+    }
+
+    _write(row, encoding, callback) {
+        var values = Array.isArray(row) ? row : this._pick(row);
+
+        if (!values) {
+            return callback(new TypeError('rows must be arrays or, with columns set, objects'));
+        }
+
+        for (var i = 0; i < values.length; i++) {
+            this._set(i, values[i]);
+        }
+
+        this.count++;
+
+        if (this.count >= this.batchSize) {
+            this._flush(callback);
+        } else {
+            callback();
+        }
+    }
+
+    _final(callback) {
+        this._flush(callback);
+    }
+
+    _pick(row) {
+        if (!this.keys || row === null || typeof row !== 'object') return null;
+
+        var values = new Array(this.keys.length);
+
+        for (var i = 0; i < this.keys.length; i++) {
+            values[i] = row[this.keys[i]];
+        }
+
+        return values;
+    }
+
+    // Columns start out as Float64Array and fall back to a plain array on the first
+    // value that is not a number
+    _set(index, value) {
+        var column = this.columns[index];
+
+        if (!column) {
+            column = this.columns[index] = new Float64Array(this.batchSize).fill(NaN);
+        }
+
+        if (column instanceof Float64Array) {
+            if (typeof value === 'number' || value === null || value === undefined) {
+                column[this.count] = typeof value === 'number' ? value : NaN;
+                return;
+            }
+
+            column = this.columns[index] = Array.from(column, (x) => (isNaN(x) ? null : x));
+        }
+
+        column[this.count] = value;
+    }
+
+    _flush(callback) {
+        if (this.count === 0) return callback();
+
+        var count = this.count;
+
+        try {
+            // Columns no row of this batch reached are written as blanks. Array.from also
+            // visits the holes of a sparse column list.
+            var columns = Array.from(this.columns, (column) => {
+                if (!column) return [];
+
+                return column instanceof Float64Array ? column.subarray(0, count) : column.slice(0, count);
+            });
+
+            this.sheet.writeColumnsAsync(this.row, this.col, columns, this.formats, (err) => {
+                if (err) return callback(err);
+
+                this.row += count;
+                callback();
+            });
+        } catch (err) {
+            return callback(err);
+        }
+
+        // The values have been copied, so the numeric columns can be reused
+        this.columns = Array.from(this.columns, (column) => (column instanceof Float64Array ? column.fill(NaN) : null));
+        this.count = 0;
+    }
+}
+
+module.exports = RowWriter;
@@ -1,3 +1,4 @@
+import { Writable } from 'stream';
 import { Format } from './format';
 import { Font } from './font';
 import { RichString } from './rich_string';
@@ -6,6 +7,70 @@ import { FormControl } from './form_control';
 import { ConditionalFormatting } from './conditional_formatting';
 import { Table } from './table';
 
+export interface CellValue {
+    type: number;
+    value: number | string | boolean | null;
+    formula: boolean;
+    date: boolean;
+    format: number;
+}
+
+export interface CellRange {
+    rowFirst?: number;
+    rowLast?: number;
+    colFirst?: number;
+    colLast?: number;
+}
+
+export interface CsvExportOptions {
+    range?: CellRange;
+    delimiter?: string;
+    quote?: string;
+    dateFormat?: 'iso' | 'number';
+    useFormulaResults?: boolean;
+}
+
+export interface AddressBatch {
+    row: Int32Array;
+    col: Int32Array;
+    rowRelative: Uint8Array;
+    colRelative: Uint8Array;
+}
+
+export type BatchValue = number | string | boolean | Date | null | undefined;
+
+export interface RowWriterOptions {
+    startRow?: number;
+    startCol?: number;
+    columns?: string[];
+    formats?: (Format | null | undefined)[];
+    batchSize?: number;
+    highWaterMark?: number;
+}
+
+export interface ArrowColumn {
+    name?: string;
+    type?: 'number' | 'string' | 'date' | 'boolean';
+    dictionary?: boolean;
+}
+
+export interface RecordsOptions {
+    headerRow?: number;
+    range?: CellRange;
+    dates?: 'iso' | 'epoch';
+    blanks?: 'omit' | 'null';
+}
+
+export interface CsvImportOptions {
+    startRow?: number;
+    startCol?: number;
+    delimiter?: string;
+    quote?: string;
+    inferTypes?: boolean;
+    dateColumns?: number[];
+    formats?: (Format | null | undefined)[];
+}
+
 export class Sheet {
     // Cell type and format
     cellType(row: number, col: number): number;
@@ -18,6 +83,7 @@ export class Sheet {
     readString(row: number, col: number, formatRef?: { format?: Format }): string;
     writeStr(row: number, col: number, value: string, format?: Format): Sheet;
     writeString(row: number, col: number, value: string, format?: Format): Sheet;
+    writeInterned(row: number, col: number, handle: number, format?: Format): Sheet;
 
     // Read/write rich string
     readRichStr(row: number, col: number, formatRef?: { format?: Format }): RichString;
@@ -53,6 +119,7 @@ export class Sheet {
 
     // Cell properties
     isDate(row: number, col: number): boolean;
+    readCell(row: number, col: number, out?: CellValue): CellValue;
     isRichStr(row: number, col: number): boolean;
 
     // Column/row dimensions
@@ -186,6 +253,59 @@ export class Sheet {
         callback: (err: Error | null, result: void) => void,
     ): Sheet;
 
+    // JSON export
+    toRecordsAsync(callback: (err: Error | null, json: Buffer) => void): Sheet;
+    toRecordsAsync(options: RecordsOptions, callback: (err: Error | null, json: Buffer) => void): Sheet;
+
+    // Batched writes
+    writeColumnsAsync(
+        row: number,
+        col: number,
+        columns: (BatchValue[] | Float64Array)[],
+        callback: (err: Error | null, rows: number) => void,
+    ): Sheet;
+    writeColumnsAsync(
+        row: number,
+        col: number,
+        columns: (BatchValue[] | Float64Array)[],
+        formats: (Format | null | undefined)[] | undefined,
+        callback: (err: Error | null, rows: number) => void,
+    ): Sheet;
+    createRowWriter(options?: RowWriterOptions): Writable;
+
+    // Arrow export
+    toArrowAsync(callback: (err: Error | null, stream: Buffer) => void): Sheet;
+    toArrowAsync(range: CellRange | null, callback: (err: Error | null, stream: Buffer) => void): Sheet;
+    toArrowAsync(
+        range: CellRange | null,
+        schema: (ArrowColumn | null | undefined)[],
+        callback: (err: Error | null, stream: Buffer) => void,
+    ): Sheet;
+
+    // Formatted text
+    readFormattedAsync(callback: (err: Error | null, rows: string[][]) => void): Sheet;
+    readFormattedAsync(range: CellRange | null, callback: (err: Error | null, rows: string[][]) => void): Sheet;
+
+    // CSV import / export
+    importCsvAsync(source: Buffer | string, callback: (err: Error | null, rows: number) => void): Sheet;
+    importCsvAsync(
+        source: Buffer | string,
+        options: CsvImportOptions,
+        callback: (err: Error | null, rows: number) => void,
+    ): Sheet;
+    exportCsvAsync(target: null | undefined, callback: (err: Error | null, result: Buffer) => void): Sheet;
+    exportCsvAsync(
+        target: null | undefined,
+        options: CsvExportOptions,
+        callback: (err: Error | null, result: Buffer) => void,
+    ): Sheet;
+    exportCsvAsync(fd: number, callback: (err: Error | null, result: number) => void): Sheet;
+    exportCsvAsync(
+        fd: number,
+        options: CsvExportOptions,
+        callback: (err: Error | null, result: number) => void,
+    ): Sheet;
+
     // Copy cell
     copyCell(rowSrc: number, colSrc: number, rowDst: number, colDst: number): Sheet;
 
@@ -330,6 +450,14 @@ export class Sheet {
     // Address conversion
     addrToRowCol(addr: string): { row: number; col: number; rowRelative: boolean; colRelative: boolean };
     rowColToAddr(row: number, col: number, rowRelative?: boolean, colRelative?: boolean): string;
+    addrsToRowCols(addrs: string[]): AddressBatch;
+    addrsToRowCols(data: Buffer, offsets: Uint32Array): AddressBatch;
+    rowColsToAddrs(
+        rows: Int32Array,
+        cols: Int32Array,
+        rowRelative?: boolean,
+        colRelative?: boolean,
+    ): { data: Buffer; offsets: Uint32Array };
 
     // Hyperlinks
     hyperlinkSize(): number;
@@ -493,6 +493,46 @@ describe('The book class', () => {
         book.addFormat();
     });
 
+    it('book.addFormat configures the new format from a spec', () => {
+        assert.throws(() => book.addFormat({ alignH: 'left' } as any), {
+            name: 'TypeError',
+            message: 'integer required for alignH',
+        });
+        assert.throws(() => book.addFormat({ font: { bold: 1 } } as any), TypeError);
+
+        const format = book.addFormat({
+            font: { name: 'times', size: 14, bold: true },
+            numFormat: '0.000',
+            alignH: xl.ALIGNH_RIGHT,
+            wrap: true,
+            border: xl.BORDERSTYLE_THIN,
+            borderTop: xl.BORDERSTYLE_THICK,
+            fillPattern: xl.FILLPATTERN_SOLID,
+            patternForegroundColor: xl.COLOR_YELLOW,
+            locked: false,
+        });
+
+        assert.strictEqual(format.font().name(), 'times');
+        assert.strictEqual(format.font().size(), 14);
+        assert.strictEqual(format.font().bold(), true);
+        assert.strictEqual(book.customNumFormat(format.numFormat()), '0.000');
+        assert.strictEqual(format.alignH(), xl.ALIGNH_RIGHT);
+        assert.strictEqual(format.wrap(), true);
+        assert.strictEqual(format.borderLeft(), xl.BORDERSTYLE_THIN);
+        assert.strictEqual(format.borderTop(), xl.BORDERSTYLE_THICK);
+        assert.strictEqual(format.fillPattern(), xl.FILLPATTERN_SOLID);
+        assert.strictEqual(format.patternForegroundColor(), xl.COLOR_YELLOW);
+        assert.strictEqual(format.locked(), false);
+
+        const derived = book.addFormat(format, { alignH: xl.ALIGNH_LEFT });
+        assert.strictEqual(derived.alignH(), xl.ALIGNH_LEFT);
+        assert.strictEqual(derived.wrap(), true);
+
+        // Repeating a custom number format code reuses its id
+        assert.strictEqual(book.addFormat({ numFormat: '0.000' }).numFormat(), format.numFormat());
+        assert.strictEqual(derived.set({ numFormat: '0.000' }).numFormat(), format.numFormat());
+    });
+
     it('book.addFormat can use a format belonging to a different book as a template', () => {
         const otherBook = new xl.Book(xl.BOOK_TYPE_XLS),
             format1 = otherBook.addFormat(),
@@ -608,6 +648,41 @@ describe('The book class', () => {
         assert.strictEqual(unpacked.msecond, 7);
     });
 
+    it('book.packDates and book.unpackDates convert dates in bulk', () => {
+        const epochMs = new Float64Array([
+            Date.UTC(1999, 1, 3, 4, 5, 6, 7),
+            Date.UTC(1900, 0, 1),
+            Date.UTC(2020, 0, 2),
+            NaN,
+        ]);
+
+        assert.throws(() => (book.packDates as any).call(book, [1, 2]));
+        assert.throws(() => (book.packDates as any).call(book, epochMs, new Float64Array(1)));
+        assert.throws(() => (book.unpackDates as any).call(book, epochMs, new Int32Array(4)));
+        assert.throws(() => (book.unpackDates as any).call({}, epochMs));
+
+        const packed = book.packDates(epochMs);
+        assert.notStrictEqual(packed, epochMs);
+        assert.strictEqual(packed[0], book.datePack(1999, 2, 3, 4, 5, 6, 7));
+        assert.strictEqual(packed[1], book.datePack(1900, 1, 1));
+        assert.strictEqual(packed[2], book.datePack(2020, 1, 2));
+        assert.ok(Number.isNaN(packed[3]));
+
+        const out = new Float64Array(4);
+        assert.strictEqual(book.unpackDates(packed, out), out);
+        assert.deepStrictEqual(Array.from(out.subarray(0, 3)), Array.from(epochMs.subarray(0, 3)));
+        assert.ok(Number.isNaN(out[3]));
+
+        // Beyond the range of a JS Date or of the date system
+        const invalid = book.packDates(new Float64Array([1e300, -8.64e15 - 1, Date.UTC(1800, 0, 1)]));
+        assert.ok(invalid.every((value) => Number.isNaN(value)));
+
+        book.setDate1904(true);
+        assert.strictEqual(book.packDates(epochMs)[2], book.datePack(2020, 1, 2));
+        book.unpackDates(book.packDates(out, out), out);
+        assert.deepStrictEqual([out[0], out[2]], [epochMs[0], epochMs[2]]);
+    });
+
     it('book.colorPack packs a color', () => {
         assert.throws(() => (book.colorPack as any).call(book, 'a', 2, 3));
         assert.throws(() => (book.colorPack as any).call({}, 1, 2, 3));
@@ -625,6 +700,30 @@ describe('The book class', () => {
         assert.strictEqual(unpacked.blue, 3);
     });
 
+    it('book.packColors and book.unpackColors convert colors in bulk', () => {
+        const rgb = new Uint8Array([1, 2, 3, 255, 0, 128]);
+
+        assert.throws(() => (book.packColors as any).call(book, [1, 2, 3]));
+        assert.throws(() => (book.packColors as any).call(book, rgb.subarray(0, 4)));
+        assert.throws(() => (book.packColors as any).call(book, rgb, new Int32Array(1)));
+        assert.throws(() => (book.packColors as any).call({}, rgb));
+
+        const colors = book.packColors(rgb);
+        assert.deepStrictEqual(Array.from(colors), [book.colorPack(1, 2, 3), book.colorPack(255, 0, 128)]);
+
+        assert.throws(() => (book.unpackColors as any).call(book, [colors[0]]));
+        assert.throws(() => (book.unpackColors as any).call(book, colors, new Uint8Array(3)));
+        assert.throws(() => (book.unpackColors as any).call({}, colors));
+
+        const out = new Uint8Array(6);
+        assert.strictEqual(book.unpackColors(colors, out), out);
+
+        for (let i = 0; i < colors.length; i++) {
+            const { red, green, blue } = book.colorUnpack(colors[i]);
+            assert.deepStrictEqual(Array.from(out.subarray(3 * i, 3 * i + 3)), [red, green, blue]);
+        }
+    });
+
     it("book.activeSheet returns the index of a book's active sheet", () => {
         book.addSheet('foo');
         book.addSheet('bar');
@@ -707,6 +806,47 @@ describe('The book class', () => {
         assert.strictEqual(compareBuffers(buffer2, fileBuffer), true);
     });
 
+    it('book.getPicturesAsync extracts several pictures into a single buffer', async () => {
+        const book = new xl.Book(xl.BOOK_TYPE_XLS),
+            file = getTestPicturePath(),
+            fileBuffer = fs.readFileSync(file);
+
+        book.addPicture(file);
+        book.addPicture(fileBuffer);
+
+        assert.throws(() => (book.getPicturesAsync as any).call({}, () => {}));
+        assert.throws(() => (book.getPicturesAsync as any).call(book, 'a', () => {}));
+        assert.throws(() => (book.getPicturesAsync as any).call(book, [0, 'a'], () => {}));
+        assert.throws(() => (book.getPicturesAsync as any).call(book, [0], () => {}, 1));
+
+        const getPicturesAsync = util.promisify(
+            (indices: Array<number> | undefined, cb: (err: Error | null, result?: xl.PictureBatch) => void) =>
+                book.getPicturesAsync(indices, cb),
+        );
+
+        const allResult = getPicturesAsync(undefined);
+        assert.throws(() => (book.sheetCount as any).call(book));
+
+        const all = (await allResult)!;
+        assert.strictEqual(all.types.length, 2);
+        assert.strictEqual(all.data.length, 2 * fileBuffer.length);
+
+        for (let i = 0; i < 2; i++) {
+            assert.strictEqual(all.types[i], xl.PICTURETYPE_JPEG);
+            assert.strictEqual(all.sizes[i], fileBuffer.length);
+            assert.strictEqual(
+                compareBuffers(all.data.subarray(all.offsets[i], all.offsets[i] + all.sizes[i]), fileBuffer),
+                true,
+            );
+        }
+
+        const selected = (await getPicturesAsync([1]))!;
+        assert.deepStrictEqual(Array.from(selected.offsets), [0]);
+        assert.strictEqual(compareBuffers(selected.data, fileBuffer), true);
+
+        await assert.rejects(getPicturesAsync([5]));
+    });
+
     describe('book.addPictureAsLinkSync', () => {
         it('adds a picture as link', () => {
             const book = new xl.Book(xl.BOOK_TYPE_XLSX);
@@ -937,6 +1077,50 @@ describe('The book class', () => {
         assert.strictEqual(book2.getSheetName(0), 'asyncSheet');
     });
 
+    it('book.dumpAsync dumps all sheets as JSON', async () => {
+        const sheet1 = book.addSheet('first'),
+            sheet2 = book.addSheet('second');
+
+        sheet1.writeStr(1, 1, 'foo');
+        sheet1.writeNum(1, 2, 10);
+        sheet1.writeFormula(2, 2, 'C2*2');
+        sheet1.writeNum(3, 1, book.datePack(2020, 1, 2), book.addFormat().setNumFormat(xl.NUMFORMAT_DATE));
+        sheet1.setMerge(4, 5, 1, 2);
+        sheet2.setHidden(xl.SHEETSTATE_HIDDEN);
+
+        assert.throws(() => (book.dumpAsync as any).call(book, 10, () => {}));
+        assert.throws(() => (book.dumpAsync as any).call(book, { dates: 'julian' }, () => {}));
+        assert.throws(() => (book.dumpAsync as any).call({}, () => {}));
+
+        const dumped = util.promisify(book.dumpAsync.bind(book))(undefined);
+        assert.throws(() => (book.sheetCount as any).call(book));
+
+        const dump: xl.BookDump = JSON.parse((await dumped).toString());
+
+        assert.strictEqual(dump.sheets.length, 2);
+        assert.strictEqual(dump.sheets[0].name, 'first');
+        assert.strictEqual(dump.sheets[0].type, xl.SHEETTYPE_SHEET);
+        assert.deepStrictEqual(dump.sheets[0].range, [1, 3, 1, 2]);
+        assert.deepStrictEqual(dump.sheets[0].merges, [[4, 5, 1, 2]]);
+        assert.deepStrictEqual(dump.sheets[0].cells[0], [1, 1, 'foo']);
+        assert.deepStrictEqual(dump.sheets[0].cells[1], [1, 2, 10]);
+        assert.strictEqual(dump.sheets[0].cells[2][3], 'C2*2');
+        assert.deepStrictEqual(dump.sheets[0].cells[3], [3, 1, '2020-01-02']);
+        assert.strictEqual(dump.sheets[1].hidden, xl.SHEETSTATE_HIDDEN);
+        assert.strictEqual(dump.sheets[1].range, null);
+        assert.deepStrictEqual(dump.sheets[1].cells, []);
+
+        const compact: xl.BookDump = JSON.parse(
+            (
+                await util.promisify(book.dumpAsync.bind(book))({ formulas: false, merges: false, dates: 'epoch' })
+            ).toString(),
+        );
+
+        assert.deepStrictEqual(compact.sheets[0].merges, []);
+        assert.strictEqual(compact.sheets[0].cells[2].length, 3);
+        assert.deepStrictEqual(compact.sheets[0].cells[3], [3, 1, Date.UTC(2020, 0, 2)]);
+    });
+
     it('book.errorCode returns an error code number', () => {
         assert.throws(() => (book.errorCode as any).call({}));
         assert.strictEqual(typeof book.errorCode(), 'number');
@@ -968,4 +1152,211 @@ describe('The book class', () => {
         assert.strictEqual(book.clear(), book);
         assert.strictEqual(book.sheetCount(), 0);
     });
+
+    it('book.setStringCacheSize and book.stringCacheStats control the read string cache', () => {
+        const book = new xl.Book(xl.BOOK_TYPE_XLSX);
+        const sheet = book.addSheet('foo');
+
+        sheet.writeStr(0, 0, 'open').writeStr(1, 0, 'closed').writeStr(2, 0, 'open');
+
+        assert.throws(() => (book.setStringCacheSize as any).call({}, 10));
+        assert.throws(() => (book.setStringCacheSize as any).call(book, 'a'));
+        assert.throws(() => book.setStringCacheSize(-1));
+        assert.throws(() => book.setStringCacheSize(2 ** 30), RangeError);
+        assert.throws(() => (book.stringCacheStats as any).call({}));
+
+        assert.deepStrictEqual(book.stringCacheStats(), { capacity: 0, size: 0, hits: 0, misses: 0 });
+
+        assert.strictEqual(book.setStringCacheSize(16), book);
+
+        // Repeated reads of the same value always hit, whatever slot the value maps to
+        assert.strictEqual(sheet.readStr(0, 0), 'open');
+        assert.strictEqual(sheet.readStr(2, 0), 'open');
+        assert.strictEqual(sheet.readStr(1, 0), 'closed');
+
+        const stats = book.stringCacheStats();
+        assert.strictEqual(stats.capacity, 16);
+        assert.strictEqual(stats.hits, 1);
+        assert.strictEqual(stats.misses, 2);
+
+        book.setStringCacheSize(0);
+        assert.strictEqual(sheet.readStr(2, 0), 'open');
+        assert.deepStrictEqual(book.stringCacheStats(), { capacity: 0, size: 0, hits: 0, misses: 0 });
+    });
+
+    it('book.internString returns handles that can be passed to sheet.writeInterned', () => {
+        const book = new xl.Book(xl.BOOK_TYPE_XLSX);
+        const anotherBook = new xl.Book(xl.BOOK_TYPE_XLSX);
+        const sheet = book.addSheet('foo');
+
+        assert.throws(() => (book.internString as any).call({}, 'foo'));
+        assert.throws(() => (book.internString as any).call(book, 1));
+
+        const unit = book.internString('kg');
+        assert.strictEqual(typeof unit, 'number');
+        assert.strictEqual(book.internString('kg'), unit);
+        assert.notStrictEqual(book.internString('€'), unit);
+
+        assert.strictEqual(sheet.writeInterned(0, 0, unit), sheet);
+        assert.strictEqual(sheet.readStr(0, 0), 'kg');
+        assert.strictEqual(sheet.writeInterned(0, 1, book.internString('€'), book.addFormat()), sheet);
+        assert.strictEqual(sheet.readStr(0, 1), '€');
+
+        // Numbers are not taken for handles by writeStr
+        assert.throws(() => (sheet.writeStr as any).call(sheet, 1, 0, unit));
+
+        assert.throws(() => (sheet.writeInterned as any).call(sheet, 1, 0, 'kg'));
+        assert.throws(() => sheet.writeInterned(1, 0, anotherBook.internString('a')));
+        assert.throws(() => sheet.writeInterned(1, 0, -1));
+        assert.throws(() => sheet.writeInterned(1, 0, unit + 0.5));
+
+        assert.throws(() => (book.clearInternedStrings as any).call({}));
+        assert.strictEqual(book.clearInternedStrings(), book);
+        assert.throws(() => sheet.writeInterned(1, 0, unit));
+        assert.notStrictEqual(book.internString('kg'), unit);
+    });
+
+    it('wrappers for sheets, formats and fonts are unique per native object', () => {
+        const book = new xl.Book(xl.BOOK_TYPE_XLSX);
+        const sheet = book.addSheet('foo');
+        const format = book.addFormat();
+        const font = book.addFont();
+
+        format.setFont(font);
+        sheet.writeNum(0, 0, 1, format);
+
+        assert.strictEqual(book.getSheet(0), sheet);
+        assert.strictEqual(book.getSheet(0), book.getSheet(0));
+        assert.strictEqual(sheet.cellFormat(0, 0), format);
+        assert.strictEqual(book.format(book.formatSize() - 1), format);
+        assert.strictEqual(format.font(), font);
+        assert.notStrictEqual(book.addFormat(), format);
+    });
+
+    it('wrappers are dropped when sheets are deleted or the book is cleared', () => {
+        const book = new xl.Book(xl.BOOK_TYPE_XLSX);
+        const deleted = book.addSheet('foo');
+
+        book.delSheet(0);
+        assert.throws(() => deleted.readNum(0, 0));
+        assert.notStrictEqual(book.addSheet('foo'), deleted);
+
+        const sheet = book.getSheet(0);
+        const format = book.addFormat();
+        const font = book.addFont();
+
+        book.clear();
+        assert.throws(() => sheet.readNum(0, 0));
+
+        const newSheet = book.addSheet('bar');
+        assert.notStrictEqual(newSheet, sheet);
+        assert.ok(newSheet instanceof xl.Sheet);
+        assert.notStrictEqual(book.addFormat(), format);
+        assert.ok(book.addFont() instanceof xl.Font);
+        assert.notStrictEqual(book.font(book.fontSize() - 1), font);
+    });
+
+    it('book.formatFor reuses formats with identical properties', () => {
+        const book = new xl.Book(xl.BOOK_TYPE_XLSX);
+
+        assert.throws(() => (book.formatFor as any).call({}, {}));
+        assert.throws(() => (book.formatFor as any).call(book, 1));
+        assert.throws(() => book.formatFor({ indent: 'a' } as any), TypeError);
+
+        const spec = {
+            font: { bold: true },
+            numFormat: '#,##0.00 "kg"',
+            border: xl.BORDERSTYLE_THIN,
+            fillPattern: xl.FILLPATTERN_SOLID,
+        };
+
+        const format = book.formatFor(spec);
+        const formatSize = book.formatSize();
+
+        assert.strictEqual(format.font().bold(), true);
+        assert.strictEqual(book.customNumFormat(format.numFormat()), '#,##0.00 "kg"');
+        assert.strictEqual(book.formatFor({ ...spec }), format);
+        const thin = xl.BORDERSTYLE_THIN;
+        assert.strictEqual(
+            book.formatFor({
+                ...spec,
+                border: undefined,
+                borderLeft: thin,
+                borderRight: thin,
+                borderTop: thin,
+                borderBottom: thin,
+            }),
+            format,
+        );
+        assert.strictEqual(book.formatSize(), formatSize);
+
+        const other = book.formatFor({ ...spec, fillPattern: xl.FILLPATTERN_NONE });
+        assert.notStrictEqual(other, format);
+        assert.strictEqual(other.numFormat(), format.numFormat());
+        assert.strictEqual(book.formatSize(), formatSize + 1);
+
+        // Formats added otherwise are found as well, modified ones are not reused
+        const manual = book.addFormat(book.format(0), { alignH: xl.ALIGNH_CENTER });
+        assert.strictEqual(book.formatFor({ alignH: xl.ALIGNH_CENTER }), manual);
+
+        format.setWrap(true);
+        assert.notStrictEqual(book.formatFor(spec), format);
+    });
+
+    it('book.fontFor reuses fonts with identical properties', () => {
+        const book = new xl.Book(xl.BOOK_TYPE_XLSX);
+
+        assert.throws(() => (book.fontFor as any).call({}, {}));
+        assert.throws(() => (book.fontFor as any).call(book, 'arial'));
+        assert.throws(() => book.fontFor({ size: '10' } as any), TypeError);
+
+        const font = book.fontFor({ name: 'Courier New', size: 9, bold: true });
+        const fontSize = book.fontSize();
+
+        assert.strictEqual(font.name(), 'Courier New');
+        assert.strictEqual(font.size(), 9);
+        assert.strictEqual(font.bold(), true);
+        assert.strictEqual(book.fontFor({ bold: true, size: 9, name: 'Courier New' }), font);
+        assert.strictEqual(book.fontSize(), fontSize);
+
+        assert.notStrictEqual(book.fontFor({ name: 'Courier New', size: 9, italic: true }), font);
+        assert.strictEqual(book.fontSize(), fontSize + 1);
+
+        assert.strictEqual(book.fontFor({}), book.font(0));
+
+        // Formats share the fonts of the registry
+        const format1 = book.formatFor({ font: { name: 'Courier New', size: 9, bold: true } });
+        const format2 = book.formatFor({ font: { name: 'Courier New', size: 9, bold: true }, wrap: true });
+        assert.strictEqual(format1.font(), format2.font());
+    });
+
+    it('book.styleSnapshot returns all formats and fonts as a struct of arrays', () => {
+        const book = new xl.Book(xl.BOOK_TYPE_XLSX);
+
+        assert.throws(() => (book.styleSnapshot as any).call({}));
+
+        const font = book.addFont().setName('Courier New').setBold(true);
+        const format = book.addFormat({ font, alignH: xl.ALIGNH_RIGHT, borderTop: xl.BORDERSTYLE_THICK, wrap: true });
+
+        const { formats, fonts } = book.styleSnapshot();
+        const i = book.formatSize() - 1;
+
+        assert.strictEqual(formats.numFormat.length, book.formatSize());
+        assert.strictEqual(fonts.size.length, book.fontSize());
+        assert.strictEqual(fonts.name.length, book.fontSize());
+        assert.ok(formats.alignH instanceof Int32Array);
+        assert.ok(formats.wrap instanceof Uint8Array);
+
+        assert.strictEqual(book.format(i), format);
+        assert.strictEqual(formats.alignH[i], xl.ALIGNH_RIGHT);
+        assert.strictEqual(formats.borderTop[i], xl.BORDERSTYLE_THICK);
+        assert.strictEqual(formats.wrap[i], 1);
+        assert.strictEqual(formats.numFormat[i], format.numFormat());
+
+        const fontIndex = formats.font[i];
+        assert.strictEqual(book.font(fontIndex), font);
+        assert.strictEqual(fonts.name[fontIndex], 'Courier New');
+        assert.strictEqual(fonts.bold[fontIndex], 1);
+        assert.strictEqual(fonts.size[fontIndex], font.size());
+    });
 });
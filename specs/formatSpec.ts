@@ -254,4 +254,35 @@ describe('The format class', () => {
         assert.strictEqual(format.setHidden(false).hidden(), false);
         assert.strictEqual(format.setHidden().hidden(), true);
     });
+
+    it('format.set applies a spec', () => {
+        assert.throws(() => (format.set as any).call({}, {}));
+        assert.throws(() => (format.set as any).call(format, 1));
+        assert.throws(() => format.set({ wrap: 1 } as any), {
+            name: 'TypeError',
+            message: 'bool required for wrap',
+        });
+        assert.throws(() => format.set({ font: new xl.Book(xl.BOOK_TYPE_XLS).addFont() }));
+
+        assert.strictEqual(
+            format.set({
+                font,
+                numFormat: xl.NUMFORMAT_PERCENT,
+                alignV: xl.ALIGNV_CENTER,
+                indent: 2,
+                borderColor: xl.COLOR_RED,
+                borderBottomColor: xl.COLOR_BLUE,
+                hidden: false,
+            }),
+            format,
+        );
+
+        assert.strictEqual(format.font().name(), 'times');
+        assert.strictEqual(format.numFormat(), xl.NUMFORMAT_PERCENT);
+        assert.strictEqual(format.alignV(), xl.ALIGNV_CENTER);
+        assert.strictEqual(format.indent(), 2);
+        assert.strictEqual(format.borderLeftColor(), xl.COLOR_RED);
+        assert.strictEqual(format.borderBottomColor(), xl.COLOR_BLUE);
+        assert.strictEqual(format.hidden(), false);
+    });
 });
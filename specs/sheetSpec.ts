@@ -1,6 +1,8 @@
 import { describe, it, beforeEach } from 'node:test';
 import assert from 'node:assert/strict';
 import util from 'util';
+import { Readable } from 'stream';
+import { pipeline } from 'stream/promises';
 import * as xl from '../lib/libxl';
 import {
     getTestPicturePath,
@@ -121,6 +123,18 @@ describe('The sheet class', () => {
         row++;
     });
 
+    it('sheet.writeStr round trips short and long non-ASCII strings', () => {
+        const short = 'grüße €';
+        const long = 'grüße € 😀 '.repeat(100);
+
+        sheet.writeStr(row, 0, short).writeStr(row, 1, long);
+
+        assert.strictEqual(sheet.readStr(row, 0), short);
+        assert.strictEqual(sheet.readStr(row, 1), long);
+
+        row++;
+    });
+
     it('sheet.readRichStr and sheet.writeRichStr read and write a rich string', () => {
         const anotherBook = new xl.Book(xl.BOOK_TYPE_XLSX);
 
@@ -180,12 +194,33 @@ describe('The sheet class', () => {
         assert.throws(() => {
             sheet.writeNum(row, 0, 10, wrongFormat);
         });
+        assert.throws(() => {
+            (sheet.writeNum as any).call(Object.create(xl.Sheet.prototype), row, 0, 10);
+        });
+        assert.throws(() => {
+            sheet.writeNum(row, 0, 10, Object.create(xl.Format.prototype));
+        });
         assert.strictEqual(sheet.writeNum(row, 0, 10), sheet);
         assert.strictEqual(sheet.writeNum(row, 0, 10, format), sheet);
 
         row++;
     });
 
+    it('argument errors name the first offending position', () => {
+        assert.throws(() => (sheet.writeNum as any)(row, 0.5, 10), {
+            name: 'TypeError',
+            message: 'integer required at position 1',
+        });
+        assert.throws(() => (sheet.writeNum as any)(row, 0, '10', {}), {
+            name: 'TypeError',
+            message: 'number required at position 2',
+        });
+        assert.throws(() => (sheet.writeNum as any)(row, 0, 10, {}), {
+            name: 'TypeError',
+            message: 'Invalid type for argument 3',
+        });
+    });
+
     it('sheet.readBool reads a bool', () => {
         sheet.writeBool(row, 0, true);
 
@@ -378,6 +413,72 @@ describe('The sheet class', () => {
         row++;
     });
 
+    it('sheet.readCell reads type, value, flags and format index in one call', () => {
+        const dateFormat = book.addFormat().setNumFormat(xl.NUMFORMAT_DATE);
+
+        sheet
+            .writeNum(row, 0, 42)
+            .writeStr(row, 1, 'foo')
+            .writeBool(row, 2, true)
+            .writeNum(row, 3, book.datePack(1980, 8, 19), dateFormat)
+            .writeFormulaNum(row, 4, '1+1', 2)
+            .writeBlank(row, 5, format);
+
+        assert.throws(() => (sheet.readCell as any).call(sheet, row, 'a'));
+        assert.throws(() => (sheet.readCell as any).call({}, row, 0));
+
+        const cell = sheet.readCell(row, 0);
+        assert.deepStrictEqual(Object.keys(cell), ['type', 'value', 'formula', 'date', 'format']);
+        assert.strictEqual(cell.type, xl.CELLTYPE_NUMBER);
+        assert.strictEqual(cell.value, 42);
+        assert.strictEqual(cell.formula, false);
+        assert.strictEqual(cell.date, false);
+        assert.strictEqual(sheet.readCell(row, 1).value, 'foo');
+        assert.strictEqual(sheet.readCell(row, 1).type, xl.CELLTYPE_STRING);
+        assert.strictEqual(sheet.readCell(row, 2).value, true);
+
+        const out = {} as xl.CellValue;
+        assert.strictEqual(sheet.readCell(row, 3, out), out);
+        assert.strictEqual(out.date, true);
+        assert.strictEqual(book.format(out.format), dateFormat);
+
+        assert.strictEqual(sheet.readCell(row, 4, out).formula, true);
+        assert.strictEqual(out.value, 2);
+
+        sheet.readCell(row, 5, out);
+        assert.strictEqual(out.type, xl.CELLTYPE_BLANK);
+        assert.strictEqual(out.value, null);
+        assert.strictEqual(book.format(out.format), format);
+
+        assert.strictEqual(sheet.readCell(row, 6, out).type, xl.CELLTYPE_EMPTY);
+        assert.strictEqual(out.format, -1);
+
+        row++;
+    });
+
+    it('cell accessors behave the same when called from optimized code', () => {
+        const dateFormat = book.addFormat().setNumFormat(xl.NUMFORMAT_DATE);
+        sheet.writeNum(row, 0, 42).writeBool(row, 1, true).writeNum(row, 2, 30000, dateFormat);
+        sheet.writeFormula(row, 3, '=1');
+
+        const probe = (r: number) =>
+            sheet.readNum(r, 0) +
+            (sheet.readBool(r, 1) ? 1 : 0) +
+            (sheet.isDate(r, 2) ? 1 : 0) +
+            (sheet.isFormula(r, 3) ? 1 : 0) +
+            sheet.cellType(r, 0);
+
+        const expected = 42 + 1 + 1 + 1 + xl.CELLTYPE_NUMBER;
+        for (let i = 0; i < 100000; i++) {
+            assert.strictEqual(probe(row), expected);
+        }
+
+        assert.throws(() => probe(row + 0.5));
+        assert.throws(() => (probe as any)('a'));
+
+        row++;
+    });
+
     it('sheet.isRichStr checks whether a cell contains a richt string', () => {
         assert.throws(() => (sheet.isRichStr as any).call(sheet, row, 'a'));
         assert.throws(() => (sheet.isRichStr as any).call({}, row, 0));
@@ -972,6 +1073,287 @@ describe('The sheet class', () => {
         assert.strictEqual(sheet.readStr(4, 4), '22');
     });
 
+    it('sheet.writeColumnsAsync writes a block of values column by column', async () => {
+        const sheet = newSheet();
+
+        assert.throws(() => (sheet.writeColumnsAsync as any).call(sheet, 0, 0, [[{}]], () => {}));
+        assert.throws(() => (sheet.writeColumnsAsync as any).call(sheet, 0, 0, [1], () => {}));
+        assert.throws(() => (sheet.writeColumnsAsync as any).call(sheet, 0, 0, [[1]], [wrongFormat], () => {}));
+        assert.throws(() => (sheet.writeColumnsAsync as any).call(sheet, -1, 0, [[1]], () => {}));
+        assert.throws(() => (sheet.writeColumnsAsync as any).call({}, 0, 0, [[1]], () => {}));
+
+        const written = util.promisify((cb) =>
+            sheet.writeColumnsAsync(1, 1, [new Float64Array([1, NaN, 3]), ['a', true, new Date(0)]], [format], cb),
+        )();
+        assert.throws(() => (book.sheetCount as any).call(book));
+
+        assert.strictEqual(await written, 3);
+        assert.strictEqual(sheet.readNum(1, 1), 1);
+        assert.strictEqual(sheet.cellType(2, 1), xl.CELLTYPE_EMPTY);
+        assert.strictEqual(sheet.cellFormat(3, 1), format);
+        assert.strictEqual(sheet.readStr(1, 2), 'a');
+        assert.strictEqual(sheet.readBool(2, 2), true);
+        assert.strictEqual(sheet.isDate(3, 2), true);
+        assert.strictEqual(sheet.readNum(3, 2), book.datePack(1970, 1, 1));
+    });
+
+    it('sheet.createRowWriter streams rows into the sheet in batches', async () => {
+        const sheet = newSheet();
+        const rows = [
+            { name: 'a', value: 1, when: new Date(Date.UTC(2020, 0, 2)) },
+            { name: 'b', value: null, when: null },
+            { name: 'c', value: 'x' },
+        ];
+
+        await pipeline(
+            Readable.from(rows),
+            sheet.createRowWriter({ startRow: 1, columns: ['name', 'value', 'when'], formats: [format], batchSize: 2 }),
+        );
+
+        assert.strictEqual(sheet.readStr(1, 0), 'a');
+        assert.strictEqual(sheet.cellFormat(1, 0), format);
+        assert.strictEqual(sheet.readNum(1, 1), 1);
+        assert.strictEqual(sheet.readNum(1, 2), book.datePack(2020, 1, 2));
+        assert.strictEqual(sheet.cellType(2, 1), xl.CELLTYPE_EMPTY);
+        assert.strictEqual(sheet.readStr(3, 0), 'c');
+        assert.strictEqual(sheet.readStr(3, 1), 'x');
+
+        await pipeline(Readable.from([['d', 4]]), sheet.createRowWriter());
+        assert.strictEqual(sheet.readStr(4, 0), 'd');
+        assert.strictEqual(sheet.readNum(4, 1), 4);
+
+        await assert.rejects(pipeline(Readable.from([{ name: 'e' }]), sheet.createRowWriter()));
+
+        // Ragged rows, with string columns that the next batch does not reach
+        await pipeline(
+            Readable.from([['f', 'g', 'h'], ['i'], [1]]),
+            sheet.createRowWriter({ startRow: 10, batchSize: 2 }),
+        );
+        assert.strictEqual(sheet.readStr(10, 2), 'h');
+        assert.strictEqual(sheet.readStr(11, 0), 'i');
+        assert.strictEqual(sheet.cellType(11, 1), xl.CELLTYPE_EMPTY);
+        assert.strictEqual(sheet.readNum(12, 0), 1);
+        assert.strictEqual(sheet.cellType(12, 1), xl.CELLTYPE_EMPTY);
+    });
+
+    it('sheet.exportCsvAsync exports a range as CSV', async () => {
+        const sheet = newSheet();
+        const dateFormat = book.addFormat().setNumFormat(xl.NUMFORMAT_DATE);
+
+        sheet
+            .writeStr(0, 0, 'a')
+            .writeStr(0, 1, 'b,c')
+            .writeNum(1, 0, 1.5)
+            .writeStr(1, 1, 'say "hi"')
+            .writeNum(2, 0, book.datePack(1980, 8, 19), dateFormat)
+            .writeBool(2, 1, true);
+
+        assert.throws(() => (sheet.exportCsvAsync as any).call(sheet, 'a', () => {}));
+        assert.throws(() => (sheet.exportCsvAsync as any).call(sheet, null, { delimiter: ';;' }, () => {}));
+        assert.throws(() => (sheet.exportCsvAsync as any).call(sheet, null, { dateFormat: 'foo' }, () => {}));
+        assert.throws(() => (sheet.exportCsvAsync as any).call(sheet, null, {}, () => {}, 1));
+        assert.throws(() => (sheet.exportCsvAsync as any).call({}, null, () => {}));
+
+        const exportCsv = util.promisify((options: xl.CsvExportOptions, cb) =>
+            sheet.exportCsvAsync(null, options, cb),
+        );
+
+        const pending = exportCsv({});
+        assert.throws(() => (book.sheetCount as any).call(book));
+
+        assert.strictEqual((await pending).toString(), 'a,"b,c"\n1.5,"say ""hi"""\n1980-08-19,TRUE\n');
+
+        const clamped = await exportCsv({ range: { rowLast: 2147483647, colLast: 16383 } });
+        assert.strictEqual(clamped.toString(), 'a,"b,c"\n1.5,"say ""hi"""\n1980-08-19,TRUE\n');
+
+        const column = await exportCsv({ range: { rowFirst: 1, colLast: 0 } });
+        assert.strictEqual(column.toString(), '1.5\n1980-08-19\n');
+
+        const unquoted = await exportCsv({ range: { rowFirst: 1 }, delimiter: ';', quote: '', dateFormat: 'number' });
+        assert.strictEqual(unquoted.toString(), '1.5;say "hi"\n29452;TRUE\n');
+    });
+
+    it('sheet.importCsvAsync imports CSV and infers cell types', async () => {
+        const sheet = newSheet();
+        const csv = 'name,count,flag,when\r\n"x, y",1.5,TRUE,2020-01-02\r\nz,"7",false,2020-01-02 10:30\r\n';
+
+        assert.throws(() => (sheet.importCsvAsync as any).call(sheet, 1, () => {}));
+        assert.throws(() => (sheet.importCsvAsync as any).call(sheet, Buffer.from(csv), { startRow: -1 }, () => {}));
+        assert.throws(() => (sheet.importCsvAsync as any).call(sheet, Buffer.from(csv), { formats: [1] }, () => {}));
+        assert.throws(() =>
+            (sheet.importCsvAsync as any).call(sheet, Buffer.from(csv), { formats: [wrongFormat] }, () => {}),
+        );
+        assert.throws(() => (sheet.importCsvAsync as any).call({}, Buffer.from(csv), () => {}));
+
+        const importCsv = util.promisify((data: Buffer | string, options: xl.CsvImportOptions, cb) =>
+            sheet.importCsvAsync(data, options, cb),
+        );
+
+        const pending = importCsv(Buffer.from(csv), { startRow: 1, startCol: 2, formats: [format] });
+        assert.throws(() => (book.sheetCount as any).call(book));
+
+        assert.strictEqual(await pending, 3);
+        assert.strictEqual(sheet.readStr(1, 2), 'name');
+        assert.strictEqual(sheet.readStr(2, 2), 'x, y');
+        assert.strictEqual(sheet.cellFormat(2, 2), format);
+        assert.strictEqual(sheet.readNum(2, 3), 1.5);
+        assert.strictEqual(sheet.readBool(2, 4), true);
+        assert.strictEqual(sheet.isDate(2, 5), true);
+        assert.strictEqual(sheet.readNum(2, 5), book.datePack(2020, 1, 2));
+        assert.strictEqual(sheet.readStr(3, 3), '7');
+        assert.strictEqual(sheet.readBool(3, 4), false);
+        assert.strictEqual(sheet.readNum(3, 5), book.datePack(2020, 1, 2, 10, 30));
+
+        const untyped = { delimiter: ';', inferTypes: false, dateColumns: [1] };
+        assert.strictEqual(await importCsv(Buffer.from('1;2020-01-02'), untyped), 1);
+        assert.strictEqual(sheet.readStr(0, 0), '1');
+        assert.strictEqual(sheet.isDate(0, 1), true);
+
+        assert.strictEqual(await importCsv(Buffer.from('2024-02-31;2024-02-29'), { delimiter: ';', startRow: 5 }), 1);
+        assert.strictEqual(sheet.readStr(5, 0), '2024-02-31');
+        assert.strictEqual(sheet.readNum(5, 1), book.datePack(2024, 2, 29));
+    });
+
+    it('sheet.toRecordsAsync exports rows as JSON records keyed by the header', async () => {
+        const sheet = newSheet();
+        const dateFormat = book.addFormat().setNumFormat(xl.NUMFORMAT_DATE);
+
+        sheet
+            .writeStr(0, 0, 'name')
+            .writeStr(0, 1, 'age')
+            .writeStr(0, 2, 'born')
+            .writeStr(1, 0, 'a "q"')
+            .writeNum(1, 1, 30)
+            .writeNum(1, 2, book.datePack(1980, 8, 19), dateFormat)
+            .writeStr(1, 3, 'no header')
+            .writeStr(2, 0, 'b')
+            .writeBool(2, 2, true);
+
+        assert.throws(() => (sheet.toRecordsAsync as any).call(sheet, { dates: 'foo' }, () => {}));
+        assert.throws(() => (sheet.toRecordsAsync as any).call(sheet, { blanks: 'foo' }, () => {}));
+        assert.throws(() => (sheet.toRecordsAsync as any).call(sheet, { headerRow: -1 }, () => {}));
+        assert.throws(() => (sheet.toRecordsAsync as any).call(sheet, {}, () => {}, 1));
+        assert.throws(() => (sheet.toRecordsAsync as any).call({}, () => {}));
+
+        const toRecords = util.promisify((options: xl.RecordsOptions, cb) => sheet.toRecordsAsync(options, cb));
+
+        const pending = toRecords({});
+        assert.throws(() => (book.sheetCount as any).call(book));
+
+        assert.deepStrictEqual(JSON.parse((await pending).toString()), [
+            { name: 'a "q"', age: 30, born: '1980-08-19' },
+            { name: 'b', born: true },
+        ]);
+
+        assert.deepStrictEqual(
+            JSON.parse((await toRecords({ headerRow: 0, range: { rowFirst: 2 }, blanks: 'null' })).toString()),
+            [{ name: 'b', age: null, born: true }],
+        );
+
+        assert.deepStrictEqual(JSON.parse((await toRecords({ range: { rowLast: 1 }, dates: 'epoch' })).toString()), [
+            { name: 'a "q"', age: 30, born: Date.UTC(1980, 7, 19) },
+        ]);
+    });
+
+    it('sheet.toArrowAsync renders a range as Arrow IPC stream', async () => {
+        const sheet = newSheet();
+        const dateFormat = book.addFormat().setNumFormat(xl.NUMFORMAT_DATE);
+
+        for (let row = 0; row < 4; row++) {
+            if (row !== 2) sheet.writeNum(row, 0, row + 0.5);
+            sheet.writeStr(row, 1, row === 1 ? 'y' : 'x');
+            sheet.writeNum(row, 2, book.datePack(2020, 1, row + 1), dateFormat);
+        }
+
+        assert.throws(() => (sheet.toArrowAsync as any).call(sheet, {}, 1, () => {}));
+        assert.throws(() => (sheet.toArrowAsync as any).call(sheet, {}, [{ type: 'foo' }], () => {}));
+        assert.throws(() => (sheet.toArrowAsync as any).call(sheet, {}, [], () => {}, 1));
+        assert.throws(() => (sheet.toArrowAsync as any).call({}, () => {}));
+
+        const toArrow = util.promisify((range: xl.CellRange | null, schema: xl.ArrowColumn[], cb) =>
+            sheet.toArrowAsync(range, schema, cb),
+        );
+
+        // Walk the encapsulated messages and pick the header type from the flatbuffer metadata
+        const headerTypes = (data: Buffer) => {
+            const types = [];
+            let offset = 0;
+
+            for (;;) {
+                assert.strictEqual(data.readUInt32LE(offset), 0xffffffff);
+                const length = data.readInt32LE(offset + 4);
+                offset += 8;
+                if (length === 0) break;
+
+                const root = data.readUInt32LE(offset) + offset;
+                const vtable = root - data.readInt32LE(root);
+                types.push(data.readUInt8(root + data.readUInt16LE(vtable + 6)));
+
+                const bodyLength = data.readBigInt64LE(root + data.readUInt16LE(vtable + 10));
+                offset += length + Number(bodyLength);
+            }
+
+            assert.strictEqual(offset, data.length);
+            return types;
+        };
+
+        const pending = toArrow(null, [{ name: 'value' }]);
+        assert.throws(() => (book.sheetCount as any).call(book));
+
+        const data = await pending;
+        assert.deepStrictEqual(headerTypes(data), [1, 2, 3]);
+        assert.notStrictEqual(data.indexOf('value'), -1);
+        assert.notStrictEqual(data.indexOf(Buffer.from(new Float64Array([0.5, 1.5, 0, 3.5]).buffer)), -1);
+
+        const plain = await toArrow({ colFirst: 1, colLast: 1 }, [{ type: 'string', dictionary: false }]);
+        assert.deepStrictEqual(headerTypes(plain), [1, 3]);
+        assert.notStrictEqual(plain.indexOf('xyxx'), -1);
+    });
+
+    it('sheet.readFormattedAsync renders cells with their number formats', async () => {
+        const sheet = newSheet();
+        const isoFormat = book.addFormat().setNumFormat(book.addCustomNumFormat('yyyy-mm-dd'));
+
+        sheet
+            .writeNum(0, 0, 1234.5, book.addFormat().setNumFormat(xl.NUMFORMAT_NUMBER_SEP_D2))
+            .writeNum(0, 1, 0.123, book.addFormat().setNumFormat(xl.NUMFORMAT_PERCENT))
+            .writeNum(0, 2, book.datePack(2024, 3, 1), book.addFormat().setNumFormat(xl.NUMFORMAT_DATE))
+            .writeNum(1, 0, book.datePack(2024, 3, 1), isoFormat)
+            .writeNum(1, 1, 0.5)
+            .writeBool(1, 2, true)
+            .writeStr(2, 0, 'foo');
+
+        assert.throws(() => (sheet.readFormattedAsync as any).call(sheet, 1, () => {}));
+        assert.throws(() => (sheet.readFormattedAsync as any).call(sheet, null, () => {}, 1));
+        assert.throws(() => (sheet.readFormattedAsync as any).call({}, () => {}));
+
+        const readFormatted = util.promisify((range: xl.CellRange | null, cb) => sheet.readFormattedAsync(range, cb));
+
+        const pending = readFormatted(null);
+        assert.throws(() => (book.sheetCount as any).call(book));
+
+        assert.deepStrictEqual(await pending, [
+            ['1,234.50', '12%', '3/1/2024'],
+            ['2024-03-01', '0.5', 'TRUE'],
+            ['foo', '', ''],
+        ]);
+
+        assert.deepStrictEqual(await readFormatted({ rowFirst: 1, rowLast: 1, colFirst: 0, colLast: 0 }), [
+            ['2024-03-01'],
+        ]);
+
+        // Serials past 9999-12-31 of the 1904 date system
+        const book1904 = new xl.Book(xl.BOOK_TYPE_XLS);
+        book1904.setDate1904(true);
+
+        const sheet1904 = book1904.addSheet('foo');
+        const dateFormat = book1904.addFormat().setNumFormat(xl.NUMFORMAT_DATE);
+        sheet1904.writeNum(0, 0, 2957003, dateFormat).writeNum(0, 1, 2957004, dateFormat);
+
+        const formatted1904 = await util.promisify((cb) => sheet1904.readFormattedAsync(null, cb))();
+        assert.deepStrictEqual(formatted1904, [['12/31/9999', '########']]);
+    });
+
     it('sheet.removeRow and sheet.removeCol remove rows and cols', () => {
         let sheet = newSheet();
 
@@ -1450,6 +1832,39 @@ describe('The sheet class', () => {
         assert.strictEqual(sheet.rowColToAddr(0, 0, false, false), '$A$1');
     });
 
+    it('sheet.rowColsToAddrs and sheet.addrsToRowCols convert addresses in bulk', () => {
+        const rows = new Int32Array([0, 9, 1048575]),
+            cols = new Int32Array([0, 27, 16383]);
+
+        assert.throws(() => (sheet.rowColsToAddrs as any).call(sheet, [0], [0]));
+        assert.throws(() => (sheet.rowColsToAddrs as any).call(sheet, rows, new Int32Array(1)));
+        assert.throws(() => (sheet.rowColsToAddrs as any).call(sheet, new Int32Array([-1]), new Int32Array([0])));
+        assert.throws(() => (sheet.rowColsToAddrs as any).call({}, rows, cols));
+
+        const { data, offsets } = sheet.rowColsToAddrs(rows, cols);
+        assert.deepStrictEqual(Array.from(offsets), [0, 2, 6, 13]);
+        assert.strictEqual(data.toString('latin1'), 'A1AB10XFD1048576');
+        assert.strictEqual(
+            sheet.rowColsToAddrs(rows.subarray(1, 2), cols.subarray(1, 2), false, false).data.toString(),
+            sheet.rowColToAddr(9, 27, false, false),
+        );
+
+        assert.throws(() => (sheet.addrsToRowCols as any).call(sheet, 'A1'));
+        assert.throws(() => (sheet.addrsToRowCols as any).call(sheet, [1]));
+        assert.throws(() => (sheet.addrsToRowCols as any).call(sheet, data, new Uint32Array([0, 100])));
+        assert.throws(() => (sheet.addrsToRowCols as any).call({}, ['A1']));
+
+        const parsed = sheet.addrsToRowCols(['A1', '$b$2', 'C$3', 'foo']);
+        assert.deepStrictEqual(Array.from(parsed.row), [0, 1, 2, -1]);
+        assert.deepStrictEqual(Array.from(parsed.col), [0, 1, 2, -1]);
+        assert.deepStrictEqual(Array.from(parsed.rowRelative), [1, 0, 0, 1]);
+        assert.deepStrictEqual(Array.from(parsed.colRelative), [1, 0, 1, 1]);
+
+        const roundTrip = sheet.addrsToRowCols(data, offsets);
+        assert.deepStrictEqual(roundTrip.row, rows);
+        assert.deepStrictEqual(roundTrip.col, cols);
+    });
+
     it('the hyperlink family of functions manages hyperlinks', () => {
         assert.throws(() => (sheet.hyperlinkSize as any).call({}));
         assert.strictEqual(sheet.hyperlinkSize(), 0);
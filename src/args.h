@@ -0,0 +1,172 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BINDINGS_ARGS_H
+#define BINDINGS_ARGS_H
+
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "common.h"
+
+namespace node_libxl {
+
+    // Marks an argument that may be undefined. Wrapped objects become nullptr, everything
+    // else a std::optional.
+    template <typename T>
+    struct Optional {};
+
+    namespace args {
+
+        // Per type conversion. The primary template handles wrapped objects (Format, Font, ...)
+        template <typename T>
+        struct Traits {
+            typedef T* Type;
+            static constexpr const char* error = "Invalid type for argument";
+
+            static bool Get(v8::Local<v8::Value> value, Type* result) {
+                *result = T::FromJS(value);
+                return *result != nullptr;
+            }
+        };
+
+        template <>
+        struct Traits<int> {
+            typedef int Type;
+            static constexpr const char* error = "integer required at position";
+
+            static bool Get(v8::Local<v8::Value> value, Type* result) {
+                if (!value->IsInt32()) return false;
+
+                *result = value.As<v8::Int32>()->Value();
+                return true;
+            }
+        };
+
+        template <>
+        struct Traits<double> {
+            typedef double Type;
+            static constexpr const char* error = "number required at position";
+
+            static bool Get(v8::Local<v8::Value> value, Type* result) {
+                if (!value->IsNumber()) return false;
+
+                *result = value.As<v8::Number>()->Value();
+                return true;
+            }
+        };
+
+        template <>
+        struct Traits<bool> {
+            typedef bool Type;
+            static constexpr const char* error = "bool required at position";
+
+            static bool Get(v8::Local<v8::Value> value, Type* result) {
+                if (!value->IsBoolean()) return false;
+
+                *result = value.As<v8::Boolean>()->Value();
+                return true;
+            }
+        };
+
+        template <typename T>
+        struct OptionalValue {
+            typedef std::optional<typename Traits<T>::Type> Type;
+            static constexpr const char* error = Traits<T>::error;
+
+            static bool Get(v8::Local<v8::Value> value, Type* result) {
+                if (value->IsUndefined()) return true;
+
+                return Traits<T>::Get(value, &result->emplace());
+            }
+        };
+
+        template <typename T>
+        struct OptionalWrapped {
+            typedef T* Type;
+            static constexpr const char* error = Traits<T>::error;
+
+            static bool Get(v8::Local<v8::Value> value, Type* result) {
+                *result = nullptr;
+                return value->IsUndefined() || Traits<T>::Get(value, result);
+            }
+        };
+
+        template <typename T>
+        struct Traits<Optional<T>>
+            : std::conditional_t<std::is_class_v<T>, OptionalWrapped<T>, OptionalValue<T>> {};
+
+    }  // namespace args
+
+    // Compile time argument schema, e.g. Args<int, int, double, Optional<Format>>. The
+    // arguments are converted in order up to the first mismatch; the error message is only
+    // assembled if it is actually thrown.
+    template <typename... T>
+    class Args {
+       public:
+        typedef std::tuple<typename args::Traits<T>::Type...> Values;
+
+        explicit Args(Nan::NAN_METHOD_ARGS_TYPE info) {
+            Unpack(info, std::index_sequence_for<T...>());
+        }
+
+        bool HasException() const { return failedPosition >= 0; }
+
+        Nan::NAN_METHOD_RETURN_TYPE ThrowException() const {
+            std::string message = std::string(error) + " " + std::to_string(failedPosition);
+
+            return Nan::ThrowTypeError(message.c_str());
+        }
+
+        const Values& Get() const { return values; }
+
+       private:
+        template <size_t... I>
+        void Unpack(Nan::NAN_METHOD_ARGS_TYPE info, std::index_sequence<I...>) {
+            (void)(Unpack<I>(info) && ...);
+        }
+
+        template <size_t I>
+        bool Unpack(Nan::NAN_METHOD_ARGS_TYPE info) {
+            typedef args::Traits<std::tuple_element_t<I, std::tuple<T...>>> Traits;
+
+            if (Traits::Get(info[I], &std::get<I>(values))) return true;
+
+            failedPosition = I;
+            error = Traits::error;
+
+            return false;
+        }
+
+        Values values{};
+        int failedPosition{-1};
+        const char* error{nullptr};
+    };
+
+}  // namespace node_libxl
+
+#endif  // BINDINGS_ARGS_H
@@ -0,0 +1,763 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "arrow_ipc.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+
+#include "cell_address.h"
+#include "keys.h"
+#include "options.h"
+#include "value_format.h"
+
+using namespace v8;
+
+namespace node_libxl {
+    namespace arrow_ipc {
+
+        namespace {
+
+            // Flatbuffer enum and union values from the Arrow format (Schema.fbs, Message.fbs)
+            const uint16_t metadataVersionV5 = 4;
+            const uint8_t headerSchema = 1, headerDictionaryBatch = 2, headerRecordBatch = 3;
+            const uint8_t typeFloatingPoint = 3, typeUtf8 = 5, typeBool = 6, typeTimestamp = 10;
+            const uint16_t precisionDouble = 2;
+            const uint16_t timeUnitMillisecond = 1;
+
+            // Minimal flatbuffer writer for the few metadata tables needed here. Objects are
+            // described as a tree and serialized front to back: every table is preceded by
+            // its vtable and followed by the objects it references, so all offsets point
+            // forward as the format requires.
+            struct FlatObject;
+            typedef std::shared_ptr<FlatObject> FlatRef;
+
+            struct FlatObject {
+                enum Kind { table, tableVector, structVector, string } kind;
+
+                struct Field {
+                    int id;
+                    int size;  // 0 for references
+                    uint64_t value;
+                    FlatRef object;
+                };
+
+                std::vector<Field> fields;
+                std::vector<FlatRef> elements;
+                std::string bytes;
+                uint32_t count{0};
+
+                explicit FlatObject(Kind kind) : kind(kind) {}
+
+                FlatObject* Scalar(int id, int size, uint64_t value) {
+                    fields.push_back({id, size, value, nullptr});
+                    return this;
+                }
+
+                FlatObject* Ref(int id, FlatRef object) {
+                    fields.push_back({id, 0, 0, object});
+                    return this;
+                }
+
+                size_t Write(std::string* out) const;
+            };
+
+            FlatRef Table() { return std::make_shared<FlatObject>(FlatObject::table); }
+
+            FlatRef String(const std::string& value) {
+                FlatRef object = std::make_shared<FlatObject>(FlatObject::string);
+                object->bytes = value;
+
+                return object;
+            }
+
+            FlatRef Tables(std::vector<FlatRef> elements) {
+                FlatRef object = std::make_shared<FlatObject>(FlatObject::tableVector);
+                object->elements = std::move(elements);
+
+                return object;
+            }
+
+            // Vector of 8 byte aligned structs, bytes holds count structs back to back
+            FlatRef Structs(uint32_t count, const std::string& bytes) {
+                FlatRef object = std::make_shared<FlatObject>(FlatObject::structVector);
+                object->count = count;
+                object->bytes = bytes;
+
+                return object;
+            }
+
+            void Pad(std::string* out, size_t alignment, size_t bias = 0) {
+                while ((out->size() + bias) % alignment) out->push_back(0);
+            }
+
+            template <typename T>
+            void Append(std::string* out, T value) {
+                out->append(reinterpret_cast<const char*>(&value), sizeof(T));
+            }
+
+            template <typename T>
+            void Patch(std::string* out, size_t position, T value) {
+                memcpy(&(*out)[position], &value, sizeof(T));
+            }
+
+            // Serialize and return the position of the object
+            size_t FlatObject::Write(std::string* out) const {
+                switch (kind) {
+                    case string: {
+                        Pad(out, 4);
+                        size_t position = out->size();
+
+                        Append<uint32_t>(out, bytes.size());
+                        out->append(bytes);
+                        out->push_back(0);
+
+                        return position;
+                    }
+
+                    case structVector: {
+                        // The elements following the length need 8 byte alignment
+                        Pad(out, 8, 4);
+                        size_t position = out->size();
+
+                        Append<uint32_t>(out, count);
+                        out->append(bytes);
+
+                        return position;
+                    }
+
+                    case tableVector: {
+                        Pad(out, 4);
+                        size_t position = out->size();
+
+                        Append<uint32_t>(out, elements.size());
+                        out->append(elements.size() * 4, 0);
+
+                        for (size_t i = 0; i < elements.size(); i++) {
+                            size_t slot = position + 4 + 4 * i;
+                            Patch<uint32_t>(out, slot, elements[i]->Write(out) - slot);
+                        }
+
+                        return position;
+                    }
+
+                    default:
+                        break;
+                }
+
+                // Inline layout: soffset to the vtable, then the fields by decreasing size
+                std::vector<const Field*> layout;
+                std::vector<uint16_t> offsets;
+                int maxId = -1;
+
+                for (const Field& field : fields) {
+                    layout.push_back(&field);
+                    if (field.id > maxId) maxId = field.id;
+                }
+
+                std::stable_sort(layout.begin(), layout.end(), [](const Field* a, const Field* b) {
+                    return (a->size ? a->size : 4) > (b->size ? b->size : 4);
+                });
+
+                offsets.resize(maxId + 1);
+                size_t tableSize = 4;
+
+                for (const Field* field : layout) {
+                    size_t size = field->size ? field->size : 4;
+
+                    tableSize = (tableSize + size - 1) / size * size;
+                    offsets[field->id] = tableSize;
+                    tableSize += size;
+                }
+
+                Pad(out, 2);
+                size_t vtable = out->size();
+
+                Append<uint16_t>(out, 4 + 2 * offsets.size());
+                Append<uint16_t>(out, tableSize);
+                for (uint16_t offset : offsets) Append<uint16_t>(out, offset);
+
+                Pad(out, 8);
+                size_t position = out->size();
+
+                out->append(tableSize, 0);
+                Patch<int32_t>(out, position, position - vtable);
+
+                for (const Field& field : fields) {
+                    size_t slot = position + offsets[field.id];
+
+                    switch (field.size) {
+                        case 1:
+                            Patch<uint8_t>(out, slot, field.value);
+                            break;
+                        case 2:
+                            Patch<uint16_t>(out, slot, field.value);
+                            break;
+                        case 4:
+                            Patch<uint32_t>(out, slot, field.value);
+                            break;
+                        case 8:
+                            Patch<uint64_t>(out, slot, field.value);
+                            break;
+                    }
+                }
+
+                for (const Field& field : fields) {
+                    if (field.size) continue;
+
+                    size_t slot = position + offsets[field.id];
+                    Patch<uint32_t>(out, slot, field.object->Write(out) - slot);
+                }
+
+                return position;
+            }
+
+            // Body buffers and field nodes of a record batch
+            class Batch {
+               public:
+                explicit Batch(int64_t length) : length(length) {}
+
+                void AddNode(int64_t nodeLength, int64_t nullCount) {
+                    Append(&nodes, nodeLength);
+                    Append(&nodes, nullCount);
+                    nodeCount++;
+                }
+
+                void AddBuffer(const void* data, size_t size) {
+                    Append<int64_t>(&buffers, body.size());
+                    Append<int64_t>(&buffers, size);
+                    bufferCount++;
+
+                    if (size) body.append(static_cast<const char*>(data), size);
+                    Pad(&body, 8);
+                }
+
+                FlatRef Table() const {
+                    FlatRef table = arrow_ipc::Table();
+
+                    table->Scalar(0, 8, length)
+                        ->Ref(1, Structs(nodeCount, nodes))
+                        ->Ref(2, Structs(bufferCount, buffers));
+
+                    return table;
+                }
+
+                const std::string& Body() const { return body; }
+
+               private:
+                int64_t length;
+                std::string body, nodes, buffers;
+                uint32_t nodeCount{0}, bufferCount{0};
+            };
+
+            // Encapsulated message: continuation marker, metadata size, metadata, body
+            void AppendMessage(std::string* out, uint8_t headerType, FlatRef header,
+                               const std::string& body) {
+                FlatRef message = Table();
+                message->Scalar(0, 2, metadataVersionV5)
+                    ->Scalar(1, 1, headerType)
+                    ->Ref(2, header)
+                    ->Scalar(3, 8, body.size());
+
+                std::string metadata(4, 0);
+                Patch<uint32_t>(&metadata, 0, message->Write(&metadata));
+                Pad(&metadata, 8);
+
+                Append<uint32_t>(out, 0xffffffff);
+                Append<uint32_t>(out, metadata.size());
+                out->append(metadata);
+                out->append(body);
+            }
+
+            struct Column {
+                std::string name;
+                ColumnType type;
+                bool dictionary{false};
+
+                int64_t nullCount{0};
+                std::vector<uint8_t> validity;
+
+                std::vector<double> numbers;
+                std::vector<int64_t> timestamps;
+                std::vector<uint8_t> booleans;
+
+                // Distinct strings and per row indices into them
+                std::vector<int32_t> offsets{0};
+                std::string characters;
+                std::vector<int32_t> indices;
+                std::unordered_map<std::string, int32_t> lookup;
+                // Length of all string values, i.e. of the characters of the plain Utf8 array
+                int64_t textSize{0};
+            };
+
+            ColumnType InferType(libxl::Sheet* sheet, const CellRange& range, int col) {
+                int numbers = 0, dates = 0, booleans = 0, strings = 0;
+
+                for (int row = range.rowFirst; row <= range.rowLast; row++) {
+                    libxl::CellType type = sheet->cellType(row, col);
+
+                    switch (type) {
+                        case libxl::CELLTYPE_NUMBER:
+                            (sheet->isDate(row, col) ? dates : numbers)++;
+                            break;
+                        case libxl::CELLTYPE_BOOLEAN:
+                            booleans++;
+                            break;
+                        case libxl::CELLTYPE_STRING:
+                        case libxl::CELLTYPE_ERROR:
+                            strings++;
+                            break;
+                        default:
+                            break;
+                    }
+                }
+
+                if (strings || (booleans && numbers + dates)) return ColumnType::string;
+                if (booleans) return ColumnType::boolean;
+                if (dates && !numbers) return ColumnType::date;
+
+                return ColumnType::number;
+            }
+
+            void AddString(Column* column, const char* value, size_t length) {
+                std::string key(value, length);
+                auto entry = column->lookup.find(key);
+
+                if (entry == column->lookup.end()) {
+                    int32_t index = column->offsets.size() - 1;
+
+                    column->characters.append(key);
+                    column->offsets.push_back(column->characters.size());
+                    entry = column->lookup.emplace(std::move(key), index).first;
+                }
+
+                column->indices.push_back(entry->second);
+                column->textSize += length;
+            }
+
+            // Append the value of one cell, returns false if the cell is null
+            bool AddCell(Column* column, libxl::Book* book, libxl::Sheet* sheet, int row, int col,
+                         bool* failed) {
+                libxl::CellType type = sheet->cellType(row, col);
+                const char* text = nullptr;
+                double number;
+                bool hasTime;
+
+                if (type == libxl::CELLTYPE_STRING) {
+                    text = sheet->readStr(row, col);
+
+                    if (!text) {
+                        *failed = true;
+                        return false;
+                    }
+                }
+
+                switch (column->type) {
+                    case ColumnType::number:
+                        if (type == libxl::CELLTYPE_NUMBER) {
+                            number = sheet->readNum(row, col);
+                        } else if (type == libxl::CELLTYPE_BOOLEAN) {
+                            number = sheet->readBool(row, col) ? 1 : 0;
+                        } else if (!text || !value_format::ParseNumber(text, strlen(text),
+                                                                       &number)) {
+                            return false;
+                        }
+
+                        column->numbers.push_back(number);
+                        return true;
+
+                    case ColumnType::date:
+                        if (type == libxl::CELLTYPE_NUMBER) {
+                            number = sheet->readNum(row, col);
+                        } else if (!text || !value_format::ParseIsoDate(text, strlen(text), book,
+                                                                        &number, &hasTime)) {
+                            return false;
+                        }
+
+                        if (!value_format::ToEpochMs(book, number, &number)) return false;
+
+                        column->timestamps.push_back(std::llround(number));
+                        return true;
+
+                    case ColumnType::boolean:
+                        if (type == libxl::CELLTYPE_BOOLEAN) {
+                            column->booleans.push_back(sheet->readBool(row, col));
+                        } else if (type == libxl::CELLTYPE_NUMBER) {
+                            column->booleans.push_back(sheet->readNum(row, col) != 0);
+                        } else {
+                            return false;
+                        }
+
+                        return true;
+
+                    default:
+                        break;
+                }
+
+                std::string rendered;
+
+                switch (type) {
+                    case libxl::CELLTYPE_STRING:
+                        AddString(column, text, strlen(text));
+                        return true;
+
+                    case libxl::CELLTYPE_NUMBER:
+                        number = sheet->readNum(row, col);
+
+                        if (!(sheet->isDate(row, col) &&
+                              value_format::AppendIsoDate(&rendered, book, number)) &&
+                            !value_format::AppendNumber(&rendered, number)) {
+                            return false;
+                        }
+
+                        break;
+
+                    case libxl::CELLTYPE_BOOLEAN:
+                        rendered = sheet->readBool(row, col) ? "TRUE" : "FALSE";
+                        break;
+
+                    case libxl::CELLTYPE_ERROR:
+                        rendered = value_format::ErrorText(sheet->readError(row, col));
+                        break;
+
+                    default:
+                        return false;
+                }
+
+                AddString(column, rendered.data(), rendered.size());
+                return true;
+            }
+
+            template <typename T>
+            void AddPlaceholder(std::vector<T>* values) {
+                values->push_back(T());
+            }
+
+            bool ReadColumn(Column* column, libxl::Book* book, libxl::Sheet* sheet,
+                            const CellRange& range, int col) {
+                int rows = range.Rows();
+                bool failed = false;
+
+                column->validity.resize((rows + 7) / 8);
+
+                for (int i = 0; i < rows; i++) {
+                    if (AddCell(column, book, sheet, range.rowFirst + i, col, &failed)) {
+                        column->validity[i / 8] |= 1 << (i % 8);
+                        continue;
+                    }
+
+                    if (failed) return false;
+
+                    // Nulls still occupy a slot
+                    column->nullCount++;
+
+                    switch (column->type) {
+                        case ColumnType::number:
+                            AddPlaceholder(&column->numbers);
+                            break;
+                        case ColumnType::date:
+                            AddPlaceholder(&column->timestamps);
+                            break;
+                        case ColumnType::boolean:
+                            AddPlaceholder(&column->booleans);
+                            break;
+                        case ColumnType::string:
+                            AddPlaceholder(&column->indices);
+                            break;
+                    }
+                }
+
+                return true;
+            }
+
+            std::vector<uint8_t> PackBits(const std::vector<uint8_t>& values) {
+                std::vector<uint8_t> bits((values.size() + 7) / 8);
+
+                for (size_t i = 0; i < values.size(); i++) {
+                    if (values[i]) bits[i / 8] |= 1 << (i % 8);
+                }
+
+                return bits;
+            }
+
+            FlatRef TypeTable(ColumnType type, uint8_t* typeType) {
+                FlatRef table = Table();
+
+                switch (type) {
+                    case ColumnType::number:
+                        *typeType = typeFloatingPoint;
+                        table->Scalar(0, 2, precisionDouble);
+                        break;
+                    case ColumnType::date:
+                        *typeType = typeTimestamp;
+                        table->Scalar(0, 2, timeUnitMillisecond);
+                        break;
+                    case ColumnType::boolean:
+                        *typeType = typeBool;
+                        break;
+                    case ColumnType::string:
+                        *typeType = typeUtf8;
+                        break;
+                }
+
+                return table;
+            }
+
+            FlatRef FieldTable(const Column& column, int64_t dictionaryId) {
+                uint8_t typeType;
+                FlatRef type = TypeTable(column.type, &typeType);
+                FlatRef field = Table();
+
+                field->Ref(0, String(column.name))
+                    ->Scalar(1, 1, 1)
+                    ->Scalar(2, 1, typeType)
+                    ->Ref(3, type)
+                    ->Ref(5, Tables({}));
+
+                if (column.dictionary) {
+                    FlatRef indexType = Table();
+                    indexType->Scalar(0, 4, 32)->Scalar(1, 1, 1);
+
+                    FlatRef encoding = Table();
+                    encoding->Scalar(0, 8, dictionaryId)->Ref(1, indexType);
+
+                    field->Ref(4, encoding);
+                }
+
+                return field;
+            }
+
+            // Utf8 array from the distinct strings of the column
+            void AddDictionary(Batch* batch, const Column& column) {
+                batch->AddNode(column.offsets.size() - 1, 0);
+                batch->AddBuffer(nullptr, 0);
+                batch->AddBuffer(column.offsets.data(), column.offsets.size() * sizeof(int32_t));
+                batch->AddBuffer(column.characters.data(), column.characters.size());
+            }
+
+            void AddColumn(Batch* batch, const Column& column, int64_t rows) {
+                batch->AddNode(rows, column.nullCount);
+
+                if (column.nullCount) {
+                    batch->AddBuffer(column.validity.data(), column.validity.size());
+                } else {
+                    batch->AddBuffer(nullptr, 0);
+                }
+
+                switch (column.type) {
+                    case ColumnType::number:
+                        batch->AddBuffer(column.numbers.data(), rows * sizeof(double));
+                        break;
+
+                    case ColumnType::date:
+                        batch->AddBuffer(column.timestamps.data(), rows * sizeof(int64_t));
+                        break;
+
+                    case ColumnType::boolean: {
+                        std::vector<uint8_t> bits = PackBits(column.booleans);
+                        batch->AddBuffer(bits.data(), bits.size());
+                        break;
+                    }
+
+                    case ColumnType::string:
+                        if (column.dictionary) {
+                            batch->AddBuffer(column.indices.data(), rows * sizeof(int32_t));
+                            break;
+                        }
+
+                        // Expand the dictionary into a plain Utf8 array
+                        std::vector<int32_t> offsets{0};
+                        std::string characters;
+
+                        for (int64_t i = 0; i < rows; i++) {
+                            if (column.validity[i / 8] & (1 << (i % 8))) {
+                                int32_t index = column.indices[i];
+                                characters.append(column.characters, column.offsets[index],
+                                                  column.offsets[index + 1] -
+                                                      column.offsets[index]);
+                            }
+
+                            offsets.push_back(characters.size());
+                        }
+
+                        batch->AddBuffer(offsets.data(), offsets.size() * sizeof(int32_t));
+                        batch->AddBuffer(characters.data(), characters.size());
+                        break;
+                }
+            }
+
+            bool ParseType(const std::string& name, ColumnType* type) {
+                static const std::pair<const char*, ColumnType> types[] = {
+                    {"number", ColumnType::number},
+                    {"string", ColumnType::string},
+                    {"date", ColumnType::date},
+                    {"boolean", ColumnType::boolean}};
+
+                for (const auto& candidate : types) {
+                    if (name == candidate.first) {
+                        *type = candidate.second;
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+        }  // namespace
+
+        bool ParseOptions(Local<Value> range, Local<Value> schema, libxl::Sheet* sheet,
+                          Options* options) {
+            Nan::HandleScope scope;
+
+            if (!cell_range::Parse(range->IsNull() ? Nan::Undefined().As<Value>() : range, sheet,
+                                   &options->range)) {
+                return false;
+            }
+
+            if (schema->IsNullOrUndefined()) return true;
+
+            if (!schema->IsArray()) {
+                Nan::ThrowTypeError("schema must be an array");
+                return false;
+            }
+
+            Local<Array> array = schema.As<Array>();
+
+            for (uint32_t i = 0; i < array->Length(); i++) {
+                Local<Value> element;
+                if (!Nan::Get(array, i).ToLocal(&element)) return false;
+
+                ColumnSchema& column = options->schema.emplace_back();
+                if (element->IsNullOrUndefined()) continue;
+
+                if (!element->IsObject()) {
+                    Nan::ThrowTypeError("schema entries must be objects");
+                    return false;
+                }
+
+                Local<Object> object = element.As<Object>();
+                std::optional<std::string> type;
+
+                if (!options::GetString(object, keys::name, &column.name) ||
+                    !options::GetString(object, keys::type, &type) ||
+                    !options::GetBoolean(object, keys::dictionary, &column.dictionary)) {
+                    return false;
+                }
+
+                if (type && !ParseType(*type, &column.type.emplace())) {
+                    Nan::ThrowTypeError(
+                        "type must be one of 'number', 'string', 'date' or 'boolean'");
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        bool Build(libxl::Book* book, libxl::Sheet* sheet, const Options& options,
+                   std::string* out, std::string* error) {
+            const CellRange& range = options.range;
+            int64_t rows = range.Rows();
+            std::vector<Column> columns(range.Cols());
+
+            for (int i = 0; i < range.Cols(); i++) {
+                Column& column = columns[i];
+                int col = range.colFirst + i;
+                const ColumnSchema* schema =
+                    static_cast<size_t>(i) < options.schema.size() ? &options.schema[i] : nullptr;
+
+                column.name =
+                    schema && schema->name ? *schema->name : cell_address::ColumnName(col);
+                column.type = schema && schema->type ? *schema->type : InferType(sheet, range, col);
+
+                if (!ReadColumn(&column, book, sheet, range, col)) {
+                    const char* message = book->errorMessage();
+                    *error = message;
+
+                    return false;
+                }
+
+                if (column.type == ColumnType::string) {
+                    size_t distinct = column.offsets.size() - 1;
+                    size_t values = rows - column.nullCount;
+
+                    column.dictionary = schema && schema->dictionary ? *schema->dictionary
+                                                                     : distinct * 2 <= values;
+
+                    // Utf8 offsets are 32 bit
+                    int64_t size = column.dictionary ? column.characters.size() : column.textSize;
+
+                    if (size > INT32_MAX) {
+                        *error = "string data of column " + column.name + " exceeds 2 GiB";
+                        return false;
+                    }
+                }
+
+                column.lookup.clear();
+            }
+
+            std::vector<FlatRef> fields;
+            int64_t dictionaryId = 0;
+
+            for (const Column& column : columns) {
+                fields.push_back(FieldTable(column, column.dictionary ? dictionaryId++ : -1));
+            }
+
+            FlatRef schema = Table();
+            schema->Ref(1, Tables(fields));
+
+            AppendMessage(out, headerSchema, schema, "");
+
+            dictionaryId = 0;
+
+            for (const Column& column : columns) {
+                if (!column.dictionary) continue;
+
+                Batch batch(column.offsets.size() - 1);
+                AddDictionary(&batch, column);
+
+                FlatRef dictionaryBatch = Table();
+                dictionaryBatch->Scalar(0, 8, dictionaryId++)->Ref(1, batch.Table());
+
+                AppendMessage(out, headerDictionaryBatch, dictionaryBatch, batch.Body());
+            }
+
+            Batch batch(rows);
+            for (const Column& column : columns) AddColumn(&batch, column, rows);
+
+            AppendMessage(out, headerRecordBatch, batch.Table(), batch.Body());
+
+            // End of stream
+            Append<uint32_t>(out, 0xffffffff);
+            Append<uint32_t>(out, 0);
+
+            return true;
+        }
+
+    }  // namespace arrow_ipc
+}  // namespace node_libxl
@@ -0,0 +1,70 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BINDINGS_ARROW_IPC_H
+#define BINDINGS_ARROW_IPC_H
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "cell_range.h"
+#include "common.h"
+
+namespace node_libxl {
+    namespace arrow_ipc {
+
+        enum class ColumnType { number, string, date, boolean };
+
+        struct ColumnSchema {
+            std::optional<std::string> name;
+            std::optional<ColumnType> type;
+            std::optional<bool> dictionary;
+        };
+
+        struct Options {
+            CellRange range;
+            // Indexed by column within the range
+            std::vector<ColumnSchema> schema;
+        };
+
+        // Read a range and an array of {name, type: 'number' | 'string' | 'date' | 'boolean',
+        // dictionary} column descriptors. Throws a TypeError and returns false if either is
+        // malformed.
+        bool ParseOptions(v8::Local<v8::Value> range, v8::Local<v8::Value> schema,
+                          libxl::Sheet* sheet, Options* options);
+
+        // Render the range as an Arrow IPC stream (schema, dictionaries, one record batch).
+        // Column types not fixed by the schema are inferred from the cells: Float64 for
+        // numbers, Timestamp(ms) for dates, Bool for booleans and Utf8 otherwise. String
+        // columns are dictionary encoded if at most half of their values are distinct. Blank
+        // cells are null. Does not touch V8 and may run on a worker thread. On failure false
+        // is returned and error set.
+        bool Build(libxl::Book* book, libxl::Sheet* sheet, const Options& options,
+                   std::string* out, std::string* error);
+
+    }  // namespace arrow_ipc
+}  // namespace node_libxl
+
+#endif  // BINDINGS_ARROW_IPC_H
@@ -27,6 +27,7 @@
 #include "argument_helper.h"
 #include "assert.h"
 #include "filter_column.h"
+#include "keys.h"
 #include "util.h"
 
 using namespace v8;
@@ -67,10 +68,10 @@ namespace node_libxl {
         }
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("rowFirst").ToLocalChecked(), Nan::New<Number>(rowFirst));
-        Nan::Set(result, Nan::New<String>("rowLast").ToLocalChecked(), Nan::New<Number>(rowLast));
-        Nan::Set(result, Nan::New<String>("colFirst").ToLocalChecked(), Nan::New<Number>(colFirst));
-        Nan::Set(result, Nan::New<String>("colLast").ToLocalChecked(), Nan::New<Number>(colLast));
+        Nan::Set(result, keys::Get(keys::rowFirst), Nan::New<Number>(rowFirst));
+        Nan::Set(result, keys::Get(keys::rowLast), Nan::New<Number>(rowLast));
+        Nan::Set(result, keys::Get(keys::colFirst), Nan::New<Number>(colFirst));
+        Nan::Set(result, keys::Get(keys::colLast), Nan::New<Number>(colLast));
 
         info.GetReturnValue().Set(result);
     }
@@ -160,10 +161,10 @@ namespace node_libxl {
         }
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("rowFirst").ToLocalChecked(), Nan::New<Number>(rowFirst));
-        Nan::Set(result, Nan::New<String>("rowLast").ToLocalChecked(), Nan::New<Number>(rowLast));
-        Nan::Set(result, Nan::New<String>("colFirst").ToLocalChecked(), Nan::New<Number>(colFirst));
-        Nan::Set(result, Nan::New<String>("colLast").ToLocalChecked(), Nan::New<Number>(colLast));
+        Nan::Set(result, keys::Get(keys::rowFirst), Nan::New<Number>(rowFirst));
+        Nan::Set(result, keys::Get(keys::rowLast), Nan::New<Number>(rowLast));
+        Nan::Set(result, keys::Get(keys::colFirst), Nan::New<Number>(colFirst));
+        Nan::Set(result, keys::Get(keys::colLast), Nan::New<Number>(colLast));
 
         info.GetReturnValue().Set(result);
     }
@@ -199,10 +200,8 @@ namespace node_libxl {
         }
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("columnIndex").ToLocalChecked(),
-                 Nan::New<Number>(columnIndex));
-        Nan::Set(result, Nan::New<String>("descending").ToLocalChecked(),
-                 Nan::New<Boolean>(descending));
+        Nan::Set(result, keys::Get(keys::columnIndex), Nan::New<Number>(columnIndex));
+        Nan::Set(result, keys::Get(keys::descending), Nan::New<Boolean>(descending));
 
         info.GetReturnValue().Set(result);
     }
@@ -271,6 +270,7 @@ namespace node_libxl {
 
         t->ReadOnlyPrototype();
         constructor.Reset(Nan::GetFunction(t).ToLocalChecked());
+        functionTemplate.Reset(t);
         Nan::Set(exports, Nan::New<String>("AutoFilter").ToLocalChecked(), Nan::New(constructor));
     }
 }  // namespace node_libxl
@@ -33,6 +33,7 @@
 #include "font.h"
 #include "form_control.h"
 #include "format.h"
+#include "keys.h"
 #include "rich_string.h"
 #include "sheet.h"
 #include "table.h"
@@ -41,6 +42,8 @@ using namespace v8;
 using namespace node_libxl;
 
 void Initialize(Local<Object> exports) {
+    keys::Initialize();
+
     Book::Initialize(exports);
     Sheet::Initialize(exports);
     Format::Initialize(exports);
@@ -24,7 +24,10 @@
 
 #include "book.h"
 
+#include <atomic>
+#include <cmath>
 #include <cstring>
+#include <vector>
 
 #include "api_key.h"
 #include "argument_helper.h"
@@ -33,12 +36,17 @@
 #include "buffer_copy.h"
 #include "conditional_format.h"
 #include "core_properties.h"
+#include "dump.h"
 #include "font.h"
 #include "format.h"
+#include "keys.h"
 #include "rich_string.h"
 #include "sheet.h"
 #include "string_copy.h"
+#include "style_snapshot.h"
+#include "style_spec.h"
 #include "util.h"
+#include "value_format.h"
 
 using namespace v8;
 
@@ -103,6 +111,56 @@ namespace node_libxl {
         return validSheetHandles.find(sheet) != validSheetHandles.end();
     }
 
+    StringCache& Book::GetStringCache() { return stringCache; }
+
+    StyleRegistry& Book::GetStyleRegistry() { return styleRegistry; }
+
+    NumberFormatCache& Book::GetNumberFormatCache() { return numberFormats; }
+
+    const char* Book::GetInternedString(double handle) const {
+        // Handles are positive integers below 2^53
+        if (!(handle >= 1 && handle <= 9007199254740991.) || handle != std::floor(handle)) {
+            return nullptr;
+        }
+
+        auto interned = internedStrings.find(static_cast<int64_t>(handle));
+
+        return interned == internedStrings.end() ? nullptr : interned->second;
+    }
+
+    Local<Object> Book::LookupWrapper(WrapperKind kind, const void* native) const {
+        const auto& map = wrappers[static_cast<int>(kind)];
+        auto wrapper = map.find(native);
+
+        return wrapper == map.end() ? Local<Object>() : wrapper->second->handle();
+    }
+
+    void Book::RegisterWrapper(WrapperKind kind, const void* native, Nan::ObjectWrap* wrapper) {
+        wrappers[static_cast<int>(kind)][native] = wrapper;
+    }
+
+    void Book::UnregisterWrapper(WrapperKind kind, const void* native,
+                                 const Nan::ObjectWrap* wrapper) {
+        auto& map = wrappers[static_cast<int>(kind)];
+        auto registered = map.find(native);
+
+        if (registered != map.end() && registered->second == wrapper) map.erase(registered);
+    }
+
+    void Book::ForgetChildren() {
+        validSheetHandles.clear();
+
+        for (auto& map : wrappers) map.clear();
+    }
+
+    void Book::RetainChild() {
+        if (childCount++ == 0) anchor.Reset(handle());
+    }
+
+    void Book::ReleaseChild() {
+        if (--childCount == 0) anchor.Reset();
+    }
+
     // Implementation
 
     NAN_METHOD(Book::LoadSync) {
@@ -118,9 +176,11 @@ namespace node_libxl {
         Book* that = FromJS(info.This());
         ASSERT_THIS(that);
 
+        that->ForgetChildren();
+
         if (!that->GetWrapped()->load(
                 *filename,
-                tempfile ? *String::Utf8Value(Isolate::GetCurrent(), *tempfile) : nullptr)) {
+                tempfile ? *Utf8Value(*tempfile) : nullptr)) {
             return util::ThrowLibxlError(that);
         }
 
@@ -162,6 +222,8 @@ namespace node_libxl {
         Book* that = FromJS(info.This());
         ASSERT_THIS(that);
 
+        that->ForgetChildren();
+
         Nan::AsyncQueueWorker(
             new Worker(new Nan::Callback(callback), info.This(), filename, tempfile));
 
@@ -183,9 +245,11 @@ namespace node_libxl {
         Book* that = FromJS(info.This());
         ASSERT_THIS(that);
 
+        that->ForgetChildren();
+
         if (!that->GetWrapped()->loadSheet(
                 *filename, sheetIndex,
-                tempfile ? *String::Utf8Value(Isolate::GetCurrent(), *tempfile) : nullptr,
+                tempfile ? *Utf8Value(*tempfile) : nullptr,
                 keepAllSheets)) {
             return util::ThrowLibxlError(that);
         }
@@ -235,6 +299,8 @@ namespace node_libxl {
         Book* that = FromJS(info.This());
         ASSERT_THIS(that);
 
+        that->ForgetChildren();
+
         Nan::AsyncQueueWorker(new Worker(new Nan::Callback(callback), info.This(), filename,
                                          sheetIndex, tempfile, keepAllSheets));
 
@@ -258,9 +324,11 @@ namespace node_libxl {
         Book* that = FromJS(info.This());
         ASSERT_THIS(that);
 
+        that->ForgetChildren();
+
         if (!that->GetWrapped()->loadPartially(
                 *filename, sheetIndex, firstRow, lastRow,
-                tempfile ? *String::Utf8Value(Isolate::GetCurrent(), *tempfile) : nullptr,
+                tempfile ? *Utf8Value(*tempfile) : nullptr,
                 keepAllSheets)) {
             return util::ThrowLibxlError(that);
         }
@@ -318,6 +386,8 @@ namespace node_libxl {
         Book* that = FromJS(info.This());
         ASSERT_THIS(that);
 
+        that->ForgetChildren();
+
         Nan::AsyncQueueWorker(new Worker(new Nan::Callback(callback), info.This(), filename,
                                          sheetIndex, firstRow, lastRow, tempfile, keepAllSheets));
 
@@ -336,6 +406,8 @@ namespace node_libxl {
         Book* that = FromJS(info.This());
         ASSERT_THIS(that);
 
+        that->ForgetChildren();
+
         if (!that->GetWrapped()->loadWithoutEmptyCells(*filename)) {
             return util::ThrowLibxlError(that);
         }
@@ -369,6 +441,8 @@ namespace node_libxl {
         Book* that = FromJS(info.This());
         ASSERT_THIS(that);
 
+        that->ForgetChildren();
+
         Nan::AsyncQueueWorker(new Worker(new Nan::Callback(callback), info.This(), filename));
 
         info.GetReturnValue().Set(info.This());
@@ -386,6 +460,8 @@ namespace node_libxl {
         Book* that = FromJS(info.This());
         ASSERT_THIS(that);
 
+        that->ForgetChildren();
+
         if (!that->GetWrapped()->loadInfo(*filename)) {
             return util::ThrowLibxlError(that);
         }
@@ -419,6 +495,8 @@ namespace node_libxl {
         Book* that = FromJS(info.This());
         ASSERT_THIS(that);
 
+        that->ForgetChildren();
+
         Nan::AsyncQueueWorker(new Worker(new Nan::Callback(callback), info.This(), filename));
 
         info.GetReturnValue().Set(info.This());
@@ -566,6 +644,8 @@ namespace node_libxl {
         Book* that = FromJS(info.This());
         ASSERT_THIS(that);
 
+        that->ForgetChildren();
+
         if (!that->GetWrapped()->loadRaw(node::Buffer::Data(buffer), node::Buffer::Length(buffer),
                                          sheetIndex, firstRow, lastRow, keepAllSheets)) {
             return util::ThrowLibxlError(that);
@@ -620,6 +700,8 @@ namespace node_libxl {
         Book* that = FromJS(info.This());
         ASSERT_THIS(that);
 
+        that->ForgetChildren();
+
         Nan::AsyncQueueWorker(new Worker(new Nan::Callback(callback), info.This(), buffer,
                                          sheetIndex, firstRow, lastRow, keepAllSheets));
 
@@ -764,7 +846,11 @@ namespace node_libxl {
         ASSERT_THIS(that);
 
         auto libxlSheet = that->GetWrapped()->getSheet(index);
-        if (libxlSheet) that->validSheetHandles.erase(libxlSheet);
+
+        if (libxlSheet) {
+            that->validSheetHandles.erase(libxlSheet);
+            that->wrappers[static_cast<int>(WrapperKind::sheet)].erase(libxlSheet);
+        }
 
         if (!that->GetWrapped()->delSheet(index)) {
             return util::ThrowLibxlError(that);
@@ -785,14 +871,83 @@ namespace node_libxl {
         info.GetReturnValue().Set(Nan::New<Integer>(that->GetWrapped()->sheetCount()));
     }
 
+    NAN_METHOD(Book::Dump) {
+        class Worker : public AsyncWorker<Book> {
+           public:
+            Worker(Nan::Callback* callback, Local<Object> that, const dump::Options& options)
+                : AsyncWorker<Book>(callback, that, "node-libxl-book-dump"), options(options) {}
+
+            virtual void Execute() {
+                std::string out, error;
+
+                if (!dump::Build(that->GetWrapped(), options, &out, &error)) {
+                    return SetErrorMessage(error.c_str());
+                }
+
+                if (!util::FitsBuffer(out.size())) {
+                    return SetErrorMessage("dump exceeds the maximum buffer size");
+                }
+
+                size = out.size();
+                buffer = new char[size];
+                memcpy(buffer, out.data(), size);
+            }
+
+            virtual void HandleOKCallback() {
+                Nan::HandleScope scope;
+
+                Local<Value> argv[] = {
+                    Nan::Undefined(),
+                    Nan::NewBuffer(buffer, static_cast<uint32_t>(size)).ToLocalChecked()};
+
+                callback->Call(2, argv, async_resource);
+            }
+
+           private:
+            dump::Options options;
+            char* buffer{nullptr};
+            size_t size{0};
+        };
+
+        Nan::HandleScope scope;
+
+        ArgumentHelper arguments(info);
+
+        if (arguments.Length() > 2) {
+            return Nan::ThrowError("too many arguments");
+        }
+
+        Local<Function> callback = arguments.GetFunction(arguments.Length() - 1);
+        ASSERT_ARGUMENTS(arguments);
+
+        Local<Value> options = arguments.Length() > 1 ? info[0] : Nan::Undefined().As<Value>();
+
+        Book* that = FromJS(info.This());
+        ASSERT_THIS(that);
+
+        dump::Options dumpOptions;
+        if (!dump::ParseOptions(options, &dumpOptions)) return;
+
+        Nan::AsyncQueueWorker(new Worker(new Nan::Callback(callback), info.This(), dumpOptions));
+
+        info.GetReturnValue().Set(info.This());
+    }
+
     NAN_METHOD(Book::AddFormat) {
         Nan::HandleScope scope;
 
         ArgumentHelper arguments(info);
 
-        node_libxl::Format* parentFormat = arguments.GetWrapped<node_libxl::Format>(0, NULL);
+        // addFormat([parentFormat], [spec]) or addFormat(spec)
+        bool specOnly = info[0]->IsObject() && !node_libxl::Format::InstanceOf(info[0]);
+        node_libxl::Format* parentFormat =
+            specOnly ? NULL : arguments.GetWrapped<node_libxl::Format>(0, NULL);
+        Local<Value> specHandle = info[specOnly ? 0 : 1];
         ASSERT_ARGUMENTS(arguments);
 
+        FormatSpec spec;
+        if (!specHandle->IsUndefined() && !style_spec::Parse(specHandle, &spec)) return;
+
         Book* that = FromJS(info.This());
         ASSERT_THIS(that);
 
@@ -800,11 +955,19 @@ namespace node_libxl {
             return Nan::ThrowError("async operation pending on parent");
         }
 
+        if (spec.fontObject) {
+            ASSERT_SAME_BOOK(spec.fontObject, that);
+        }
+
         libxl::Book* libxlBook = that->GetWrapped();
+        if (!that->styleRegistry.ResolveNumFormat(libxlBook, &spec)) {
+            return util::ThrowLibxlError(libxlBook);
+        }
+
         libxl::Format* libxlFormat =
             libxlBook->addFormat(parentFormat ? parentFormat->GetWrapped() : NULL);
 
-        if (!libxlFormat) {
+        if (!libxlFormat || !style_spec::Apply(spec, libxlBook, libxlFormat)) {
             return util::ThrowLibxlError(libxlBook);
         }
 
@@ -1030,17 +1193,61 @@ namespace node_libxl {
         }
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("year").ToLocalChecked(), Nan::New<Integer>(year));
-        Nan::Set(result, Nan::New<String>("month").ToLocalChecked(), Nan::New<Integer>(month));
-        Nan::Set(result, Nan::New<String>("day").ToLocalChecked(), Nan::New<Integer>(day));
-        Nan::Set(result, Nan::New<String>("hour").ToLocalChecked(), Nan::New<Integer>(hour));
-        Nan::Set(result, Nan::New<String>("minute").ToLocalChecked(), Nan::New<Integer>(minute));
-        Nan::Set(result, Nan::New<String>("second").ToLocalChecked(), Nan::New<Integer>(second));
-        Nan::Set(result, Nan::New<String>("msecond").ToLocalChecked(), Nan::New<Integer>(msecond));
+        Nan::Set(result, keys::Get(keys::year), Nan::New<Integer>(year));
+        Nan::Set(result, keys::Get(keys::month), Nan::New<Integer>(month));
+        Nan::Set(result, keys::Get(keys::day), Nan::New<Integer>(day));
+        Nan::Set(result, keys::Get(keys::hour), Nan::New<Integer>(hour));
+        Nan::Set(result, keys::Get(keys::minute), Nan::New<Integer>(minute));
+        Nan::Set(result, keys::Get(keys::second), Nan::New<Integer>(second));
+        Nan::Set(result, keys::Get(keys::msecond), Nan::New<Integer>(msecond));
 
         info.GetReturnValue().Set(result);
     }
 
+    namespace {
+
+        using DateConversion = void (*)(libxl::Book*, const double*, double*, size_t);
+
+        // Shared by packDates / unpackDates: convert a Float64Array into out, or into a new
+        // array if out is missing
+        void ConvertDates(const Nan::FunctionCallbackInfo<Value>& info, DateConversion convert) {
+            Nan::HandleScope scope;
+
+            if (info.Length() < 1 || info.Length() > 2) {
+                return Nan::ThrowError("one or two arguments required");
+            }
+
+            if (!info[0]->IsFloat64Array()) {
+                return Nan::ThrowTypeError("Float64Array required at position 0");
+            }
+
+            Local<Float64Array> values = info[0].As<Float64Array>();
+            Local<Float64Array> out;
+
+            if (info.Length() < 2 || info[1]->IsUndefined()) {
+                Nan::TypedArrayContents<double> contents(values);
+                out = util::NewTypedArray<Float64Array>(*contents, contents.length());
+            } else if (!info[1]->IsFloat64Array()) {
+                return Nan::ThrowTypeError("Float64Array required at position 1");
+            } else if ((out = info[1].As<Float64Array>())->Length() != values->Length()) {
+                return Nan::ThrowTypeError("output array must have the same length");
+            }
+
+            Book* that = Book::FromJS(info.This());
+            ASSERT_THIS(that);
+
+            Nan::TypedArrayContents<double> input(values), output(out);
+            convert(that->GetWrapped(), *input, *output, input.length());
+
+            info.GetReturnValue().Set(out);
+        }
+
+    }  // namespace
+
+    NAN_METHOD(Book::PackDates) { ConvertDates(info, value_format::FromEpochMs); }
+
+    NAN_METHOD(Book::UnpackDates) { ConvertDates(info, value_format::ToEpochMs); }
+
     NAN_METHOD(Book::ColorPack) {
         Nan::HandleScope scope;
 
@@ -1072,13 +1279,98 @@ namespace node_libxl {
 
         that->GetWrapped()->colorUnpack(static_cast<libxl::Color>(value), &red, &green, &blue);
 
-        Nan::Set(result, Nan::New<String>("red").ToLocalChecked(), Nan::New<Integer>(red));
-        Nan::Set(result, Nan::New<String>("green").ToLocalChecked(), Nan::New<Integer>(green));
-        Nan::Set(result, Nan::New<String>("blue").ToLocalChecked(), Nan::New<Integer>(blue));
+        Nan::Set(result, keys::Get(keys::red), Nan::New<Integer>(red));
+        Nan::Set(result, keys::Get(keys::green), Nan::New<Integer>(green));
+        Nan::Set(result, keys::Get(keys::blue), Nan::New<Integer>(blue));
 
         info.GetReturnValue().Set(result);
     }
 
+    NAN_METHOD(Book::PackColors) {
+        Nan::HandleScope scope;
+
+        if (info.Length() < 1 || info.Length() > 2) {
+            return Nan::ThrowError("one or two arguments required");
+        }
+
+        if (!info[0]->IsUint8Array()) {
+            return Nan::ThrowTypeError("Uint8Array of RGB triplets required at position 0");
+        }
+
+        Nan::TypedArrayContents<uint8_t> rgb(info[0]);
+
+        if (rgb.length() % 3) {
+            return Nan::ThrowTypeError("RGB triplets must have a length divisible by 3");
+        }
+
+        size_t count = rgb.length() / 3;
+        Local<Int32Array> out;
+
+        if (info.Length() < 2 || info[1]->IsUndefined()) {
+            out = util::NewTypedArray<Int32Array, int32_t>(count);
+        } else if (!info[1]->IsInt32Array()) {
+            return Nan::ThrowTypeError("Int32Array required at position 1");
+        } else if ((out = info[1].As<Int32Array>())->Length() != count) {
+            return Nan::ThrowTypeError("output array must hold one color per triplet");
+        }
+
+        Book* that = FromJS(info.This());
+        ASSERT_THIS(that);
+
+        libxl::Book* book = that->GetWrapped();
+        Nan::TypedArrayContents<int32_t> colors(out);
+
+        for (size_t i = 0; i < count; i++) {
+            const uint8_t* triplet = *rgb + 3 * i;
+            (*colors)[i] = book->colorPack(triplet[0], triplet[1], triplet[2]);
+        }
+
+        info.GetReturnValue().Set(out);
+    }
+
+    NAN_METHOD(Book::UnpackColors) {
+        Nan::HandleScope scope;
+
+        if (info.Length() < 1 || info.Length() > 2) {
+            return Nan::ThrowError("one or two arguments required");
+        }
+
+        if (!info[0]->IsInt32Array()) {
+            return Nan::ThrowTypeError("Int32Array of colors required at position 0");
+        }
+
+        Nan::TypedArrayContents<int32_t> colors(info[0]);
+        size_t count = colors.length();
+        Local<Uint8Array> out;
+
+        if (info.Length() < 2 || info[1]->IsUndefined()) {
+            out = util::NewTypedArray<Uint8Array, uint8_t>(count * 3);
+        } else if (!info[1]->IsUint8Array()) {
+            return Nan::ThrowTypeError("Uint8Array required at position 1");
+        } else if ((out = info[1].As<Uint8Array>())->Length() != count * 3) {
+            return Nan::ThrowTypeError("output array must hold one RGB triplet per color");
+        }
+
+        Book* that = FromJS(info.This());
+        ASSERT_THIS(that);
+
+        libxl::Book* book = that->GetWrapped();
+        Nan::TypedArrayContents<uint8_t> rgb(out);
+
+        for (size_t i = 0; i < count; i++) {
+            int red, green, blue;
+            uint8_t* triplet = *rgb + 3 * i;
+
+            book->colorUnpack(static_cast<libxl::Color>((*colors)[i]), &red, &green, &blue);
+
+            triplet[0] = red;
+            triplet[1] = green;
+            triplet[2] = blue;
+        }
+
+        info.GetReturnValue().Set(out);
+    }
+
     NAN_METHOD(Book::ActiveSheet) {
         Nan::HandleScope scope;
 
@@ -1139,9 +1431,8 @@ namespace node_libxl {
         memcpy(buffer, data, size);
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("type").ToLocalChecked(), Nan::New<Integer>(pictureType));
-        Nan::Set(result, Nan::New<String>("data").ToLocalChecked(),
-                 Nan::NewBuffer(buffer, size).ToLocalChecked());
+        Nan::Set(result, keys::Get(keys::type), Nan::New<Integer>(pictureType));
+        Nan::Set(result, keys::Get(keys::data), Nan::NewBuffer(buffer, size).ToLocalChecked());
 
         info.GetReturnValue().Set(result);
     }
@@ -1196,6 +1487,129 @@ namespace node_libxl {
         info.GetReturnValue().Set(info.This());
     }
 
+    NAN_METHOD(Book::GetPicturesAsync) {
+        class Worker : public AsyncWorker<Book> {
+           public:
+            Worker(Nan::Callback* callback, Local<Object> that, std::vector<int>&& indices,
+                   bool allPictures)
+                : AsyncWorker<Book>(callback, that, "node-libxl-book-get-pictures-async"),
+                  indices(std::move(indices)),
+                  allPictures(allPictures) {}
+
+            ~Worker() { delete[] buffer; }
+
+            virtual void Execute() {
+                libxl::Book* book = that->GetWrapped();
+
+                if (allPictures) {
+                    indices.resize(book->pictureSize());
+                    for (size_t i = 0; i < indices.size(); i++) indices[i] = i;
+                }
+
+                std::vector<const char*> data(indices.size());
+                offsets.resize(indices.size());
+                sizes.resize(indices.size());
+                types.resize(indices.size());
+
+                // The picture data stays owned by libxl until the book is modified, so collect
+                // the pointers first and copy everything into a single allocation
+                uint64_t totalSize = 0;
+                for (size_t i = 0; i < indices.size(); i++) {
+                    unsigned size;
+
+                    types[i] = book->getPicture(indices[i], &data[i], &size);
+                    if (types[i] == libxl::PICTURETYPE_ERROR) return RaiseLibxlError();
+
+                    offsets[i] = totalSize;
+                    sizes[i] = size;
+                    totalSize += size;
+                }
+
+                if (totalSize > UINT32_MAX) return SetErrorMessage("pictures exceed 4GB");
+
+                size = totalSize;
+                buffer = new char[size];
+
+                for (size_t i = 0; i < indices.size(); i++) {
+                    memcpy(buffer + offsets[i], data[i], sizes[i]);
+                }
+            }
+
+            virtual void HandleOKCallback() {
+                Nan::HandleScope scope;
+
+                Local<Object> result = Nan::New<Object>();
+
+                Nan::Set(result, keys::Get(keys::data),
+                         Nan::NewBuffer(buffer, size).ToLocalChecked());
+                Nan::Set(result, keys::Get(keys::offsets),
+                         util::NewTypedArray<Uint32Array>(offsets.data(), offsets.size()));
+                Nan::Set(result, keys::Get(keys::sizes),
+                         util::NewTypedArray<Uint32Array>(sizes.data(), sizes.size()));
+                Nan::Set(result, keys::Get(keys::types),
+                         util::NewTypedArray<Int32Array>(types.data(), types.size()));
+
+                // Ownership of the data has been passed on to the buffer
+                buffer = nullptr;
+
+                Local<Value> argv[] = {Nan::Undefined(), result};
+                callback->Call(2, argv, async_resource);
+            }
+
+           private:
+            std::vector<int> indices;
+            bool allPictures;
+
+            std::vector<uint32_t> offsets, sizes;
+            std::vector<int32_t> types;
+            char* buffer{nullptr};
+            uint32_t size{0};
+        };
+
+        Nan::HandleScope scope;
+
+        ArgumentHelper arguments(info);
+
+        if (arguments.Length() > 2) {
+            return Nan::ThrowError("too many arguments");
+        }
+
+        bool allPictures = arguments.Length() < 2 || info[0]->IsUndefined();
+        std::vector<int> indices;
+
+        if (!allPictures) {
+            if (!info[0]->IsArray() && !info[0]->IsInt32Array()) {
+                return Nan::ThrowTypeError("array of picture indices required at position 0");
+            }
+
+            Local<Object> array = info[0].As<Object>();
+            uint32_t length = info[0]->IsArray() ? array.As<Array>()->Length()
+                                                 : array.As<Int32Array>()->Length();
+
+            indices.reserve(length);
+            for (uint32_t i = 0; i < length; i++) {
+                Local<Value> index = Nan::Get(array, i).ToLocalChecked();
+
+                if (!index->IsInt32()) {
+                    return Nan::ThrowTypeError("picture indices must be integers");
+                }
+
+                indices.push_back(Nan::To<int32_t>(index).FromJust());
+            }
+        }
+
+        Local<Function> callback = arguments.GetFunction(arguments.Length() - 1);
+        ASSERT_ARGUMENTS(arguments);
+
+        Book* that = FromJS(info.This());
+        ASSERT_THIS(that);
+
+        Nan::AsyncQueueWorker(new Worker(new Nan::Callback(callback), info.This(),
+                                         std::move(indices), allPictures));
+
+        info.GetReturnValue().Set(info.This());
+    }
+
     NAN_METHOD(Book::AddPicture) {
         Nan::HandleScope scope;
 
@@ -1398,9 +1812,8 @@ namespace node_libxl {
         }
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("name").ToLocalChecked(),
-                 Nan::New<String>(name).ToLocalChecked());
-        Nan::Set(result, Nan::New<String>("size").ToLocalChecked(), Nan::New<Integer>(size));
+        Nan::Set(result, keys::Get(keys::name), Nan::New<String>(name).ToLocalChecked());
+        Nan::Set(result, keys::Get(keys::size), Nan::New<Integer>(size));
 
         info.GetReturnValue().Set(result);
     }
@@ -1711,6 +2124,8 @@ namespace node_libxl {
         Book* that = FromJS(info.This());
         ASSERT_THIS(that);
 
+        that->ForgetChildren();
+
         if (!that->GetWrapped()->loadInfoRaw(node::Buffer::Data(buffer),
                                               node::Buffer::Length(buffer))) {
             return util::ThrowLibxlError(that);
@@ -1747,6 +2162,8 @@ namespace node_libxl {
         Book* that = FromJS(info.This());
         ASSERT_THIS(that);
 
+        that->ForgetChildren();
+
         Nan::AsyncQueueWorker(new Worker(new Nan::Callback(callback), info.This(), buffer));
 
         info.GetReturnValue().Set(info.This());
@@ -1805,11 +2222,154 @@ namespace node_libxl {
         Book* that = FromJS(info.This());
         ASSERT_THIS(that);
 
+        that->ForgetChildren();
+
         that->GetWrapped()->clear();
 
         info.GetReturnValue().Set(info.This());
     }
 
+    NAN_METHOD(Book::SetStringCacheSize) {
+        Nan::HandleScope scope;
+
+        ArgumentHelper arguments(info);
+
+        int size = arguments.GetInt(0);
+        ASSERT_ARGUMENTS(arguments);
+
+        Book* that = FromJS(info.This());
+        ASSERT_THIS(that);
+
+        if (size < 0) {
+            return Nan::ThrowTypeError("cache size must not be negative");
+        }
+
+        if (static_cast<size_t>(size) > StringCache::maxCapacity) {
+            return Nan::ThrowRangeError("cache size must not exceed 1048576");
+        }
+
+        that->stringCache.SetCapacity(size);
+
+        info.GetReturnValue().Set(info.This());
+    }
+
+    NAN_METHOD(Book::StringCacheStats) {
+        Nan::HandleScope scope;
+
+        ArgumentHelper arguments(info);
+        ASSERT_ARGUMENTS(arguments);
+
+        Book* that = FromJS(info.This());
+        ASSERT_THIS(that);
+
+        const StringCache& cache = that->stringCache;
+        Local<Object> result = Nan::New<Object>();
+
+        Nan::Set(result, keys::Get(keys::capacity),
+                 Nan::New<Number>(static_cast<double>(cache.Capacity())));
+        Nan::Set(result, keys::Get(keys::size),
+                 Nan::New<Number>(static_cast<double>(cache.Size())));
+        Nan::Set(result, keys::Get(keys::hits),
+                 Nan::New<Number>(static_cast<double>(cache.Hits())));
+        Nan::Set(result, keys::Get(keys::misses),
+                 Nan::New<Number>(static_cast<double>(cache.Misses())));
+
+        info.GetReturnValue().Set(result);
+    }
+
+    NAN_METHOD(Book::InternString) {
+        Nan::HandleScope scope;
+
+        ArgumentHelper arguments(info);
+
+        CSNanUtf8Value(value, arguments.GetString(0));
+        ASSERT_ARGUMENTS(arguments);
+
+        Book* that = FromJS(info.This());
+        ASSERT_THIS(that);
+
+        // Handles are drawn from a process wide counter (books may live on different threads),
+        // so they stay unique across books and across clears
+        static std::atomic<int64_t> nextHandle{1};
+
+        auto inserted =
+            that->internedStringHandles.emplace(std::string(*value, value.length()), 0);
+
+        // Map nodes are stable, so the key can be handed to libxl directly on write
+        if (inserted.second) {
+            inserted.first->second = nextHandle++;
+            that->internedStrings.emplace(inserted.first->second, inserted.first->first.c_str());
+        }
+
+        info.GetReturnValue().Set(Nan::New<Number>(static_cast<double>(inserted.first->second)));
+    }
+
+    NAN_METHOD(Book::ClearInternedStrings) {
+        Nan::HandleScope scope;
+
+        ArgumentHelper arguments(info);
+        ASSERT_ARGUMENTS(arguments);
+
+        Book* that = FromJS(info.This());
+        ASSERT_THIS(that);
+
+        that->internedStrings.clear();
+        that->internedStringHandles.clear();
+
+        info.GetReturnValue().Set(info.This());
+    }
+
+    NAN_METHOD(Book::FormatFor) {
+        Nan::HandleScope scope;
+
+        FormatSpec spec;
+        if (!style_spec::Parse(info[0], &spec)) return;
+
+        Book* that = FromJS(info.This());
+        ASSERT_THIS(that);
+
+        if (spec.fontObject) {
+            ASSERT_SAME_BOOK(spec.fontObject, that);
+        }
+
+        libxl::Book* libxlBook = that->GetWrapped();
+        libxl::Format* libxlFormat = that->styleRegistry.FormatFor(libxlBook, std::move(spec));
+
+        if (!libxlFormat) {
+            return util::ThrowLibxlError(libxlBook);
+        }
+
+        info.GetReturnValue().Set(Format::NewInstance(libxlFormat, info.This()));
+    }
+
+    NAN_METHOD(Book::FontFor) {
+        Nan::HandleScope scope;
+
+        FontSpec spec;
+        if (!style_spec::Parse(info[0], &spec)) return;
+
+        Book* that = FromJS(info.This());
+        ASSERT_THIS(that);
+
+        libxl::Book* libxlBook = that->GetWrapped();
+        libxl::Font* libxlFont = that->styleRegistry.FontFor(libxlBook, spec);
+
+        if (!libxlFont) {
+            return util::ThrowLibxlError(libxlBook);
+        }
+
+        info.GetReturnValue().Set(Font::NewInstance(libxlFont, info.This()));
+    }
+
+    NAN_METHOD(Book::StyleSnapshot) {
+        Nan::HandleScope scope;
+
+        Book* that = FromJS(info.This());
+        ASSERT_THIS(that);
+
+        info.GetReturnValue().Set(style_snapshot::Create(that->GetWrapped()));
+    }
+
     // Init
 
     void Book::Initialize(Local<Object> exports) {
@@ -1859,6 +2419,7 @@ namespace node_libxl {
         Nan::SetPrototypeMethod(t, "moveSheet", MoveSheet);
         Nan::SetPrototypeMethod(t, "delSheet", DelSheet);
         Nan::SetPrototypeMethod(t, "sheetCount", SheetCount);
+        Nan::SetPrototypeMethod(t, "dumpAsync", Dump);
         Nan::SetPrototypeMethod(t, "addFormat", AddFormat);
         Nan::SetPrototypeMethod(t, "addFormatFromStyle", AddFormatFromStyle);
         Nan::SetPrototypeMethod(t, "addFont", AddFont);
@@ -1872,14 +2433,19 @@ namespace node_libxl {
         Nan::SetPrototypeMethod(t, "fontSize", FontSize);
         Nan::SetPrototypeMethod(t, "datePack", DatePack);
         Nan::SetPrototypeMethod(t, "dateUnpack", DateUnpack);
+        Nan::SetPrototypeMethod(t, "packDates", PackDates);
+        Nan::SetPrototypeMethod(t, "unpackDates", UnpackDates);
         Nan::SetPrototypeMethod(t, "colorPack", ColorPack);
         Nan::SetPrototypeMethod(t, "colorUnpack", ColorUnpack);
+        Nan::SetPrototypeMethod(t, "packColors", PackColors);
+        Nan::SetPrototypeMethod(t, "unpackColors", UnpackColors);
         Nan::SetPrototypeMethod(t, "activeSheet", ActiveSheet);
         Nan::SetPrototypeMethod(t, "setActiveSheet", SetActiveSheet);
         Nan::SetPrototypeMethod(t, "pictureSize", PictureSize);
         Nan::SetPrototypeMethod(t, "getPicture", GetPicture);
         Nan::SetPrototypeMethod(t, "getPictureSync", GetPicture);
         Nan::SetPrototypeMethod(t, "getPictureAsync", GetPictureAsync);
+        Nan::SetPrototypeMethod(t, "getPicturesAsync", GetPicturesAsync);
         Nan::SetPrototypeMethod(t, "addPicture", AddPicture);
         Nan::SetPrototypeMethod(t, "addPictureSync", AddPicture);
         Nan::SetPrototypeMethod(t, "addPictureAsync", AddPictureAsync);
@@ -1915,6 +2481,13 @@ namespace node_libxl {
         Nan::SetPrototypeMethod(t, "conditionalFormat", ConditionalFormat);
         Nan::SetPrototypeMethod(t, "conditionalFormatSize", ConditionalFormatSize);
         Nan::SetPrototypeMethod(t, "clear", Clear);
+        Nan::SetPrototypeMethod(t, "setStringCacheSize", SetStringCacheSize);
+        Nan::SetPrototypeMethod(t, "stringCacheStats", StringCacheStats);
+        Nan::SetPrototypeMethod(t, "internString", InternString);
+        Nan::SetPrototypeMethod(t, "clearInternedStrings", ClearInternedStrings);
+        Nan::SetPrototypeMethod(t, "formatFor", FormatFor);
+        Nan::SetPrototypeMethod(t, "fontFor", FontFor);
+        Nan::SetPrototypeMethod(t, "styleSnapshot", StyleSnapshot);
 
 #ifdef INCLUDE_API_KEY
         CSNanObjectSetWithAttributes(exports, Nan::New<String>("apiKeyCompiledIn").ToLocalChecked(),
@@ -1928,6 +2501,7 @@ namespace node_libxl {
 
         t->ReadOnlyPrototype();
         constructor.Reset(Nan::GetFunction(t).ToLocalChecked());
+        functionTemplate.Reset(t);
         Nan::Set(exports, Nan::New<String>("Book").ToLocalChecked(), Nan::New(constructor));
 
         NODE_DEFINE_CONSTANT(exports, BOOK_TYPE_XLS);
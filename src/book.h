@@ -25,9 +25,16 @@
 #ifndef BINDINGS_BOOK
 #define BINDINGS_BOOK
 
+#include <cstdint>
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "common.h"
+#include "number_format.h"
+#include "string_cache.h"
+#include "style_registry.h"
 #include "wrapper.h"
 
 namespace node_libxl {
@@ -45,6 +52,31 @@ namespace node_libxl {
 
         bool IsValidSheet(const libxl::Sheet* sheet) const;
 
+        StringCache& GetStringCache();
+        StyleRegistry& GetStyleRegistry();
+        NumberFormatCache& GetNumberFormatCache();
+        // nullptr unless handle was returned by internString on this book and not cleared since
+        const char* GetInternedString(double handle) const;
+
+        // Identity map of the live Format / Font / Sheet wrappers that belong to this book. Each
+        // class has its own map, so an address that libxl reuses for an object of another class
+        // never yields a wrapper of the wrong type.
+        enum class WrapperKind { sheet, format, font };
+
+        v8::Local<v8::Object> LookupWrapper(WrapperKind kind, const void* native) const;
+        void RegisterWrapper(WrapperKind kind, const void* native, Nan::ObjectWrap* wrapper);
+        void UnregisterWrapper(WrapperKind kind, const void* native,
+                               const Nan::ObjectWrap* wrapper);
+
+        // Drop the identity map and the valid sheets when the contents of the book are replaced,
+        // as libxl frees all sheets, formats and fonts
+        void ForgetChildren();
+
+        // Child wrappers (sheets, formats, fonts, ...) keep the JS book alive through a single
+        // strong handle that is held while at least one of them exists
+        void RetainChild();
+        void ReleaseChild();
+
         static void Initialize(v8::Local<v8::Object> exports);
 
        protected:
@@ -74,6 +106,7 @@ namespace node_libxl {
         static NAN_METHOD(MoveSheet);
         static NAN_METHOD(DelSheet);
         static NAN_METHOD(SheetCount);
+        static NAN_METHOD(Dump);
         static NAN_METHOD(AddFormat);
         static NAN_METHOD(AddFormatFromStyle);
         static NAN_METHOD(AddFont);
@@ -87,13 +120,18 @@ namespace node_libxl {
         static NAN_METHOD(AddConditionalFormat);
         static NAN_METHOD(DatePack);
         static NAN_METHOD(DateUnpack);
+        static NAN_METHOD(PackDates);
+        static NAN_METHOD(UnpackDates);
         static NAN_METHOD(ColorPack);
         static NAN_METHOD(ColorUnpack);
+        static NAN_METHOD(PackColors);
+        static NAN_METHOD(UnpackColors);
         static NAN_METHOD(ActiveSheet);
         static NAN_METHOD(SetActiveSheet);
         static NAN_METHOD(PictureSize);
         static NAN_METHOD(GetPicture);
         static NAN_METHOD(GetPictureAsync);
+        static NAN_METHOD(GetPicturesAsync);
         static NAN_METHOD(AddPicture);
         static NAN_METHOD(AddPictureAsync);
         static NAN_METHOD(AddPictureAsLink);
@@ -126,9 +164,25 @@ namespace node_libxl {
         static NAN_METHOD(ConditionalFormat);
         static NAN_METHOD(ConditionalFormatSize);
         static NAN_METHOD(Clear);
+        static NAN_METHOD(SetStringCacheSize);
+        static NAN_METHOD(StringCacheStats);
+        static NAN_METHOD(InternString);
+        static NAN_METHOD(ClearInternedStrings);
+        static NAN_METHOD(FormatFor);
+        static NAN_METHOD(FontFor);
+        static NAN_METHOD(StyleSnapshot);
 
        private:
         std::unordered_set<const libxl::Sheet*> validSheetHandles;
+        StringCache stringCache;
+        StyleRegistry styleRegistry;
+        NumberFormatCache numberFormats;
+        // Handles are unique across all books, so a handle from another book is rejected
+        std::unordered_map<std::string, int64_t> internedStringHandles;
+        std::unordered_map<int64_t, const char*> internedStrings;
+        std::unordered_map<const void*, Nan::ObjectWrap*> wrappers[3];
+        Nan::Persistent<v8::Object> anchor;
+        size_t childCount{0};
 
        private:
         Book(const Book&);
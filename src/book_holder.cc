@@ -31,29 +31,34 @@ using namespace v8;
 
 namespace node_libxl {
 
-    BookHolder::BookHolder(Local<Value> bookHandle) {
-        if (!Book::FromJS(bookHandle)) {
+    BookHolder::BookHolder(Local<Value> bookHandle) : book(Book::FromJS(bookHandle)) {
+        if (!book) {
             std::cerr << "libxl bindings: internal error: handle is not a book instance"
                       << std::endl;
 
             abort();
         }
 
-        this->bookHandle.Reset(bookHandle);
+        book->RetainChild();
     }
 
-    BookHolder::~BookHolder() { bookHandle.Reset(); }
+    BookHolder::~BookHolder() {
+        if (identityKey) book->UnregisterWrapper(identityKind, identityKey, identityWrapper);
 
-    v8::Local<v8::Value> BookHolder::GetBookHandle() {
-        Nan::EscapableHandleScope scope;
-
-        return scope.Escape(Nan::New(bookHandle));
+        book->ReleaseChild();
     }
 
-    Book* BookHolder::GetBook() {
-        Nan::HandleScope scope;
+    void BookHolder::RegisterIdentity(Book::WrapperKind kind, const void* native,
+                                      Nan::ObjectWrap* wrapper) {
+        identityKind = kind;
+        identityKey = native;
+        identityWrapper = wrapper;
 
-        return Book::FromJS(Nan::New(bookHandle));
+        book->RegisterWrapper(kind, native, wrapper);
     }
 
+    v8::Local<v8::Value> BookHolder::GetBookHandle() { return book->handle(); }
+
+    Book* BookHolder::GetBook() { return book; }
+
 }  // namespace node_libxl
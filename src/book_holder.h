@@ -39,7 +39,9 @@ namespace node_libxl {
         Book* GetBook();
 
        protected:
-        Nan::Persistent<v8::Value> bookHandle;
+        // Make the wrapper the canonical JS object for native until it is garbage collected
+        void RegisterIdentity(Book::WrapperKind kind, const void* native,
+                              Nan::ObjectWrap* wrapper);
 
         // We need to template this in order to unwrap the correct object
         // pointer
@@ -52,6 +54,14 @@ namespace node_libxl {
         template <typename T>
         static NAN_GETTER(BookAccessor);
 
+        // The book is kept alive by its anchor as long as we are retained, so the pointer
+        // stays valid. It is also usable from weak and fast API callbacks.
+        Book* book;
+
+        Book::WrapperKind identityKind{Book::WrapperKind::sheet};
+        const void* identityKey{nullptr};
+        const Nan::ObjectWrap* identityWrapper{nullptr};
+
         BookHolder();
         BookHolder(const BookHolder&);
         const BookHolder& operator=(const BookHolder&);
@@ -76,7 +86,7 @@ namespace node_libxl {
             dynamic_cast<BookHolder*>(Nan::ObjectWrap::Unwrap<T>(info.This()));
 
         if (bookWrapper) {
-            info.GetReturnValue().Set(Nan::New(bookWrapper->bookHandle));
+            info.GetReturnValue().Set(bookWrapper->GetBookHandle());
         } else {
             return;
         }
@@ -0,0 +1,108 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "cell_address.h"
+
+namespace node_libxl {
+    namespace cell_address {
+
+        namespace {
+
+            // Beyond the largest sheets libxl writes (XFD1048576)
+            const int maxLetters = 3;
+            const int maxDigits = 7;
+
+        }  // namespace
+
+        std::string ColumnName(int col) {
+            std::string name;
+
+            for (col++; col > 0; col = (col - 1) / 26) {
+                name.insert(name.begin(), 'A' + (col - 1) % 26);
+            }
+
+            return name;
+        }
+
+        void Append(std::string* out, int row, int col, bool rowRelative, bool colRelative) {
+            char buffer[24];
+            char* end = buffer + sizeof(buffer);
+            char* begin = end;
+
+            // Built back to front
+            for (unsigned value = static_cast<unsigned>(row) + 1; value > 0; value /= 10) {
+                *--begin = '0' + value % 10;
+            }
+
+            if (!rowRelative) *--begin = '$';
+
+            for (col++; col > 0; col = (col - 1) / 26) {
+                *--begin = 'A' + (col - 1) % 26;
+            }
+
+            if (!colRelative) *--begin = '$';
+
+            out->append(begin, end);
+        }
+
+        bool Parse(const char* text, size_t length, int* row, int* col, bool* rowRelative,
+                   bool* colRelative) {
+            size_t pos = 0;
+            int letters = 0, digits = 0, parsedCol = 0, parsedRow = 0;
+
+            *colRelative = !(pos < length && text[pos] == '$');
+            if (!*colRelative) pos++;
+
+            for (; pos < length && letters <= maxLetters; pos++, letters++) {
+                char c = text[pos];
+
+                if (c >= 'a' && c <= 'z') c -= 'a' - 'A';
+                if (c < 'A' || c > 'Z') break;
+
+                parsedCol = parsedCol * 26 + (c - 'A' + 1);
+            }
+
+            *rowRelative = !(pos < length && text[pos] == '$');
+            if (!*rowRelative) pos++;
+
+            for (; pos < length && digits <= maxDigits; pos++, digits++) {
+                char c = text[pos];
+                if (c < '0' || c > '9') break;
+
+                parsedRow = parsedRow * 10 + (c - '0');
+            }
+
+            if (pos != length || letters == 0 || letters > maxLetters || digits == 0 ||
+                digits > maxDigits || parsedRow == 0) {
+                return false;
+            }
+
+            *row = parsedRow - 1;
+            *col = parsedCol - 1;
+
+            return true;
+        }
+
+    }  // namespace cell_address
+}  // namespace node_libxl
@@ -0,0 +1,48 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BINDINGS_CELL_ADDRESS_H
+#define BINDINGS_CELL_ADDRESS_H
+
+#include <string>
+
+namespace node_libxl {
+    namespace cell_address {
+
+        // Column letters (A, B, ..., Z, AA, ...) of a zero based column index
+        std::string ColumnName(int col);
+
+        // Append an A1 style address, with $ before absolute parts. row and col must not be
+        // negative.
+        void Append(std::string* out, int row, int col, bool rowRelative, bool colRelative);
+
+        // Parse an A1 style address (letters are case insensitive, $ marks absolute parts)
+        // spanning the whole input. Returns false if the address is malformed.
+        bool Parse(const char* text, size_t length, int* row, int* col, bool* rowRelative,
+                   bool* colRelative);
+
+    }  // namespace cell_address
+}  // namespace node_libxl
+
+#endif  // BINDINGS_CELL_ADDRESS_H
@@ -0,0 +1,83 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "cell_range.h"
+
+#include <algorithm>
+
+#include "keys.h"
+#include "options.h"
+
+using namespace v8;
+
+namespace node_libxl {
+    namespace cell_range {
+
+        bool Parse(Local<Value> value, libxl::Sheet* sheet, CellRange* range) {
+            Nan::HandleScope scope;
+
+            // lastRow / lastCol point behind the last used row / column
+            int firstRow = sheet->firstRow(), lastRow = sheet->lastRow();
+            int firstCol = sheet->firstCol(), lastCol = sheet->lastCol();
+
+            range->rowFirst = firstRow;
+            range->rowLast = lastRow - 1;
+            range->colFirst = firstCol;
+            range->colLast = lastCol - 1;
+
+            if (value->IsUndefined()) return true;
+
+            if (!value->IsObject()) {
+                options::ThrowPropertyError("object", keys::range);
+                return false;
+            }
+
+            Local<Object> object = value.As<Object>();
+            std::optional<int> rowFirst, rowLast, colFirst, colLast;
+
+            if (!options::GetInt(object, keys::rowFirst, &rowFirst) ||
+                !options::GetInt(object, keys::rowLast, &rowLast) ||
+                !options::GetInt(object, keys::colFirst, &colFirst) ||
+                !options::GetInt(object, keys::colLast, &colLast)) {
+                return false;
+            }
+
+            if ((rowFirst && *rowFirst < 0) || (colFirst && *colFirst < 0)) {
+                Nan::ThrowTypeError("invalid range");
+                return false;
+            }
+
+            range->rowFirst = rowFirst.value_or(range->rowFirst);
+            range->colFirst = colFirst.value_or(range->colFirst);
+
+            // Cells behind the used area are blank, so the range never needs to extend past it.
+            // This also keeps Rows() / Cols() and everything sized by them bounded.
+            range->rowLast = std::min(rowLast.value_or(range->rowLast), lastRow - 1);
+            range->colLast = std::min(colLast.value_or(range->colLast), lastCol - 1);
+
+            return true;
+        }
+
+    }  // namespace cell_range
+}  // namespace node_libxl
@@ -0,0 +1,54 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BINDINGS_CELL_RANGE_H
+#define BINDINGS_CELL_RANGE_H
+
+#include "common.h"
+
+namespace node_libxl {
+
+    // Inclusive block of cells
+    struct CellRange {
+        int rowFirst{0};
+        int rowLast{-1};
+        int colFirst{0};
+        int colLast{-1};
+
+        bool IsEmpty() const { return rowLast < rowFirst || colLast < colFirst; }
+        int Rows() const { return IsEmpty() ? 0 : rowLast - rowFirst + 1; }
+        int Cols() const { return IsEmpty() ? 0 : colLast - colFirst + 1; }
+    };
+
+    namespace cell_range {
+
+        // Read {rowFirst, rowLast, colFirst, colLast}. Missing bounds (or a missing range)
+        // default to the used area of the sheet, and the last row / column are clamped to it.
+        // Throws a TypeError and returns false if the range is malformed.
+        bool Parse(v8::Local<v8::Value> value, libxl::Sheet* sheet, CellRange* range);
+
+    }  // namespace cell_range
+}  // namespace node_libxl
+
+#endif  // BINDINGS_CELL_RANGE_H
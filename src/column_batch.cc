@@ -0,0 +1,208 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "column_batch.h"
+
+#include <cmath>
+
+#include "format.h"
+#include "style_registry.h"
+#include "util.h"
+#include "value_format.h"
+
+using namespace v8;
+
+namespace node_libxl {
+
+    bool ColumnBatch::Parse(Local<Value> columnsValue, Local<Value> formatsValue, Book* book) {
+        Nan::HandleScope scope;
+
+        if (!columnsValue->IsArray()) {
+            Nan::ThrowTypeError("columns must be an array");
+            return false;
+        }
+
+        Local<Array> columnArray = columnsValue.As<Array>();
+        columns.resize(columnArray->Length());
+
+        for (uint32_t i = 0; i < columnArray->Length(); i++) {
+            Local<Value> column;
+
+            if (!Nan::Get(columnArray, i).ToLocal(&column) || !ParseColumn(column, &columns[i])) {
+                return false;
+            }
+
+            if (columns[i].cells.size() > static_cast<size_t>(rows)) {
+                rows = columns[i].cells.size();
+            }
+        }
+
+        if (formatsValue->IsNullOrUndefined()) return true;
+
+        if (!formatsValue->IsArray()) {
+            Nan::ThrowTypeError("formats must be an array");
+            return false;
+        }
+
+        Local<Array> formatArray = formatsValue.As<Array>();
+
+        for (uint32_t i = 0; i < formatArray->Length() && i < columns.size(); i++) {
+            Local<Value> element;
+            if (!Nan::Get(formatArray, i).ToLocal(&element)) return false;
+
+            if (element->IsNullOrUndefined()) continue;
+
+            Format* format = Format::FromJS(element);
+
+            if (!format) {
+                Nan::ThrowTypeError("formats must be an array of formats");
+                return false;
+            }
+
+            if (!util::IsSameBook(format, book)) {
+                Nan::ThrowTypeError("parent books differ");
+                return false;
+            }
+
+            columns[i].format = format->GetWrapped();
+        }
+
+        return true;
+    }
+
+    bool ColumnBatch::ParseColumn(Local<Value> value, Column* column) {
+        if (value->IsFloat64Array()) {
+            Nan::TypedArrayContents<double> contents(value);
+
+            column->cells.reserve(contents.length());
+
+            for (size_t i = 0; i < contents.length(); i++) {
+                double number = (*contents)[i];
+
+                column->cells.push_back({std::isnan(number) ? Kind::blank : Kind::number, number});
+            }
+
+            return true;
+        }
+
+        if (!value->IsArray()) {
+            Nan::ThrowTypeError("columns must be arrays or Float64Arrays");
+            return false;
+        }
+
+        Local<Array> array = value.As<Array>();
+        column->cells.reserve(array->Length());
+
+        for (uint32_t i = 0; i < array->Length(); i++) {
+            Local<Value> element;
+            if (!Nan::Get(array, i).ToLocal(&element)) return false;
+
+            if (element->IsNumber()) {
+                double number = Nan::To<double>(element).FromJust();
+                column->cells.push_back({std::isnan(number) ? Kind::blank : Kind::number, number});
+            } else if (element->IsString()) {
+                column->cells.push_back({Kind::string, static_cast<double>(strings.size())});
+
+                CSNanUtf8Value(string, element);
+                strings.append(*string, string.length());
+                strings.push_back(0);
+            } else if (element->IsBoolean()) {
+                column->cells.push_back({Kind::boolean, element->IsTrue() ? 1. : 0.});
+            } else if (element->IsDate()) {
+                column->cells.push_back({Kind::date, element.As<Date>()->ValueOf()});
+            } else if (element->IsNullOrUndefined()) {
+                column->cells.push_back({Kind::blank, 0});
+            } else {
+                Nan::ThrowTypeError(
+                    "cell values must be numbers, strings, booleans, dates, null or undefined");
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool ColumnBatch::Write(libxl::Book* book, StyleRegistry* registry, libxl::Sheet* sheet,
+                            int row, int col, std::string* error) const {
+        libxl::Format* dateFormats[2] = {nullptr, nullptr};
+
+        for (size_t i = 0; i < columns.size(); i++) {
+            const Column& column = columns[i];
+            int sheetCol = col + static_cast<int>(i);
+
+            for (size_t j = 0; j < column.cells.size(); j++) {
+                const Cell& cell = column.cells[j];
+                int sheetRow = row + static_cast<int>(j);
+                libxl::Format* format = column.format;
+                double serial;
+                bool success = true;
+
+                switch (cell.kind) {
+                    case Kind::number:
+                        success = sheet->writeNum(sheetRow, sheetCol, cell.value, format);
+                        break;
+
+                    case Kind::string:
+                        success = sheet->writeStr(sheetRow, sheetCol,
+                                                  strings.data() + static_cast<size_t>(cell.value),
+                                                  format);
+                        break;
+
+                    case Kind::boolean:
+                        success = sheet->writeBool(sheetRow, sheetCol, cell.value != 0, format);
+                        break;
+
+                    case Kind::date: {
+                        // Invalid dates are left blank, like NaN
+                        if (!value_format::FromEpochMs(book, cell.value, &serial)) break;
+
+                        if (!format) {
+                            bool withTime = std::fmod(cell.value, 86400000.) != 0;
+                            libxl::Format*& dateFormat = dateFormats[withTime];
+
+                            if (!dateFormat) dateFormat = registry->DateFormat(book, withTime);
+                            if (!(format = dateFormat)) success = false;
+                        }
+
+                        success = success && sheet->writeNum(sheetRow, sheetCol, serial, format);
+                        break;
+                    }
+
+                    default:
+                        break;
+                }
+
+                if (!success) {
+                    const char* message = book->errorMessage();
+                    *error = message;
+
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+}  // namespace node_libxl
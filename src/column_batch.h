@@ -0,0 +1,81 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BINDINGS_COLUMN_BATCH_H
+#define BINDINGS_COLUMN_BATCH_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common.h"
+
+namespace node_libxl {
+
+    class Book;
+    class StyleRegistry;
+
+    // Block of cell values copied out of JavaScript, to be written to a sheet off the main
+    // thread
+    class ColumnBatch {
+       public:
+        // columns is an array of columns, each an array of numbers, strings, booleans, Dates
+        // and blanks (null / undefined) or a Float64Array (NaN being blank). formats holds an
+        // optional format per column and must belong to book. Throws a TypeError and returns
+        // false if the input is malformed.
+        bool Parse(v8::Local<v8::Value> columns, v8::Local<v8::Value> formats, Book* book);
+
+        // Write the batch with its top left corner at row / col. Dates without a column
+        // format get a date format from the registry. Does not touch V8 and may run on a
+        // worker thread. On failure false is returned and error set.
+        bool Write(libxl::Book* book, StyleRegistry* registry, libxl::Sheet* sheet, int row,
+                   int col, std::string* error) const;
+
+        int Rows() const { return rows; }
+
+       private:
+        enum class Kind : uint8_t { blank, number, string, boolean, date };
+
+        struct Cell {
+            Kind kind;
+            // Number, boolean, epoch milliseconds or offset into strings
+            double value;
+        };
+
+        struct Column {
+            std::vector<Cell> cells;
+            libxl::Format* format{nullptr};
+        };
+
+        bool ParseColumn(v8::Local<v8::Value> value, Column* column);
+
+        std::vector<Column> columns;
+        // NUL terminated strings back to back
+        std::string strings;
+        int rows{0};
+    };
+
+}  // namespace node_libxl
+
+#endif  // BINDINGS_COLUMN_BATCH_H
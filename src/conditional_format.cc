@@ -489,6 +489,7 @@ namespace node_libxl {
 
         t->ReadOnlyPrototype();
         constructor.Reset(Nan::GetFunction(t).ToLocalChecked());
+        functionTemplate.Reset(t);
         Nan::Set(exports, Nan::New<String>("ConditionalFormat").ToLocalChecked(),
                  Nan::New(constructor));
     }
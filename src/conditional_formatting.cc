@@ -316,6 +316,7 @@ namespace node_libxl {
 
         t->ReadOnlyPrototype();
         constructor.Reset(Nan::GetFunction(t).ToLocalChecked());
+        functionTemplate.Reset(t);
         Nan::Set(exports, Nan::New<String>("ConditionalFormatting").ToLocalChecked(),
                  Nan::New(constructor));
     }
@@ -457,6 +457,7 @@ namespace node_libxl {
 
         t->ReadOnlyPrototype();
         constructor.Reset(Nan::GetFunction(t).ToLocalChecked());
+        functionTemplate.Reset(t);
         Nan::Set(exports, Nan::New<String>("CoreProperties").ToLocalChecked(),
                  Nan::New(constructor));
     }
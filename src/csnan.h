@@ -25,6 +25,8 @@
 #ifndef BINDINGS_CSNAN_H
 #define BINDINGS_CSNAN_H
 
+#include "utf8_value.h"
+
 #define CSNanNewExternal(Value) v8::External::New(v8::Isolate::GetCurrent(), Value)
 
 #define CSNanObjectSetWithAttributes(Object, Key, Value, Attribs)                            \
@@ -35,6 +37,6 @@
 #define CSNanNewInstance(handle, argv, argc) \
     (handle)->NewInstance(Isolate::GetCurrent()->GetCurrentContext(), argv, argc).ToLocalChecked()
 
-#define CSNanUtf8Value(name, value) String::Utf8Value name(v8::Isolate::GetCurrent(), value)
+#define CSNanUtf8Value(name, value) node_libxl::Utf8Value name(value)
 
 #endif  // BINDINGS_CSNAN_H
@@ -0,0 +1,516 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "csv.h"
+
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "format.h"
+#include "keys.h"
+#include "options.h"
+#include "style_registry.h"
+#include "util.h"
+#include "value_format.h"
+
+using namespace v8;
+
+namespace node_libxl {
+    namespace csv {
+
+        namespace {
+
+            // Output is handed to the file descriptor in chunks of roughly this size
+            const size_t flushThreshold = 1 << 20;
+
+            bool GetChar(Local<Object> object, keys::Key key, bool allowEmpty, char* result) {
+                std::optional<std::string> value;
+                if (!options::GetString(object, key, &value)) return false;
+                if (!value) return true;
+
+                if (value->size() > 1 || (value->empty() && !allowEmpty)) {
+                    options::ThrowPropertyError("single character", key);
+                    return false;
+                }
+
+                *result = value->empty() ? 0 : (*value)[0];
+                return true;
+            }
+
+            bool WriteAll(int fd, const std::string& data, std::string* error) {
+                size_t offset = 0;
+
+                while (offset < data.size()) {
+#ifdef _WIN32
+                    int count = _write(fd, data.data() + offset,
+                                       static_cast<unsigned>(data.size() - offset));
+#else
+                    ssize_t count = write(fd, data.data() + offset, data.size() - offset);
+#endif
+
+                    if (count < 0) {
+                        if (errno == EINTR) continue;
+
+                        *error = strerror(errno);
+                        return false;
+                    }
+
+                    offset += count;
+                }
+
+                return true;
+            }
+
+            void AppendField(std::string* out, const char* value, size_t length,
+                             const ExportOptions& options) {
+                bool quote = options.quote &&
+                             memchr(value, options.delimiter, length) != nullptr;
+
+                for (size_t i = 0; i < length && options.quote && !quote; i++) {
+                    char c = value[i];
+                    quote = c == options.quote || c == '\n' || c == '\r';
+                }
+
+                if (!quote) {
+                    out->append(value, length);
+                    return;
+                }
+
+                out->push_back(options.quote);
+
+                for (size_t i = 0; i < length; i++) {
+                    if (value[i] == options.quote) out->push_back(options.quote);
+                    out->push_back(value[i]);
+                }
+
+                out->push_back(options.quote);
+            }
+
+            bool AppendCell(std::string* out, libxl::Book* book, libxl::Sheet* sheet, int row,
+                            int col, const ExportOptions& options) {
+                if (!options.useFormulaResults && sheet->isFormula(row, col)) {
+                    const char* formula = sheet->readFormula(row, col);
+                    if (!formula) return false;
+
+                    std::string text = std::string("=") + formula;
+                    AppendField(out, text.data(), text.size(), options);
+
+                    return true;
+                }
+
+                libxl::CellType type = sheet->cellType(row, col);
+
+                switch (type) {
+                    case libxl::CELLTYPE_NUMBER: {
+                        double value = sheet->readNum(row, col);
+
+                        if (!(options.isoDates && sheet->isDate(row, col) &&
+                              value_format::AppendIsoDate(out, book, value))) {
+                            value_format::AppendNumber(out, value);
+                        }
+
+                        return true;
+                    }
+
+                    case libxl::CELLTYPE_STRING: {
+                        const char* value = sheet->readStr(row, col);
+                        if (!value) return false;
+
+                        AppendField(out, value, strlen(value), options);
+                        return true;
+                    }
+
+                    case libxl::CELLTYPE_BOOLEAN:
+                        out->append(sheet->readBool(row, col) ? "TRUE" : "FALSE");
+                        return true;
+
+                    case libxl::CELLTYPE_ERROR:
+                        out->append(value_format::ErrorText(sheet->readError(row, col)));
+                        return true;
+
+                    default:
+                        return true;
+                }
+            }
+
+            // keyword must be lower case
+            bool EqualsIgnoreCase(const char* text, size_t length, const char* keyword) {
+                if (length != strlen(keyword)) return false;
+
+                for (size_t i = 0; i < length; i++) {
+                    if (tolower(static_cast<unsigned char>(text[i])) != keyword[i]) return false;
+                }
+
+                return true;
+            }
+
+            class Importer {
+               public:
+                Importer(libxl::Book* book, StyleRegistry* registry, libxl::Sheet* sheet,
+                         const ImportOptions& options)
+                    : book(book), registry(registry), sheet(sheet), options(options) {}
+
+                bool Run(const char* data, size_t size, int* rows);
+
+               private:
+                bool WriteField(int row, int col, const char* text, size_t length, bool quoted);
+                libxl::Format* DateFormat(bool hasTime);
+
+                libxl::Book* book;
+                StyleRegistry* registry;
+                libxl::Sheet* sheet;
+                const ImportOptions& options;
+
+                std::string field;
+                libxl::Format* dateFormat{nullptr};
+                libxl::Format* dateTimeFormat{nullptr};
+            };
+
+            bool Importer::Run(const char* data, size_t size, int* rows) {
+                const char* end = data + size;
+                const char* p = data;
+                int row = 0, col = 0;
+
+                // UTF-8 byte order mark
+                if (size >= 3 && memcmp(p, "\xEF\xBB\xBF", 3) == 0) p += 3;
+
+                *rows = 0;
+
+                while (p < end) {
+                    const char* text;
+                    size_t length;
+                    bool quoted = options.quote && *p == options.quote;
+
+                    if (quoted) {
+                        field.clear();
+                        p++;
+
+                        while (p < end) {
+                            if (*p != options.quote) {
+                                field.push_back(*p++);
+                            } else if (p + 1 < end && p[1] == options.quote) {
+                                field.push_back(options.quote);
+                                p += 2;
+                            } else {
+                                p++;
+                                break;
+                            }
+                        }
+
+                        // Garbage between the closing quote and the delimiter is kept
+                        while (p < end && *p != options.delimiter && *p != '\n' && *p != '\r') {
+                            field.push_back(*p++);
+                        }
+
+                        text = field.data();
+                        length = field.size();
+                    } else {
+                        text = p;
+
+                        while (p < end && *p != options.delimiter && *p != '\n' && *p != '\r') {
+                            p++;
+                        }
+
+                        length = p - text;
+                    }
+
+                    if (!WriteField(row, col, text, length, quoted)) return false;
+
+                    if (p < end && *p == options.delimiter) {
+                        p++;
+                        col++;
+
+                        // A trailing delimiter opens an empty last field
+                        if (p < end && *p != '\n' && *p != '\r') continue;
+                    }
+
+                    if (p < end && *p == '\r') p++;
+                    if (p < end && *p == '\n') p++;
+
+                    row++;
+                    col = 0;
+                    *rows = row;
+                }
+
+                return true;
+            }
+
+            bool Importer::WriteField(int row, int col, const char* text, size_t length,
+                                      bool quoted) {
+                if (length == 0) return true;
+
+                row += options.startRow;
+                bool isDateColumn = static_cast<size_t>(col) < options.dateColumns.size() &&
+                                    options.dateColumns[col];
+                libxl::Format* format = static_cast<size_t>(col) < options.formats.size()
+                                            ? options.formats[col]
+                                            : nullptr;
+                int sheetCol = col + options.startCol;
+
+                double number;
+                bool hasTime;
+
+                if ((isDateColumn || (options.inferTypes && !quoted)) &&
+                    value_format::ParseIsoDate(text, length, book, &number, &hasTime)) {
+                    if (!format && !(format = DateFormat(hasTime))) return false;
+
+                    return sheet->writeNum(row, sheetCol, number, format);
+                }
+
+                if (options.inferTypes && !quoted) {
+                    if (value_format::ParseNumber(text, length, &number)) {
+                        return sheet->writeNum(row, sheetCol, number, format);
+                    }
+
+                    if (EqualsIgnoreCase(text, length, "true")) {
+                        return sheet->writeBool(row, sheetCol, true, format);
+                    }
+
+                    if (EqualsIgnoreCase(text, length, "false")) {
+                        return sheet->writeBool(row, sheetCol, false, format);
+                    }
+                }
+
+                // writeStr needs a terminated string
+                if (text != field.data()) field.assign(text, length);
+
+                return sheet->writeStr(row, sheetCol, field.c_str(), format);
+            }
+
+            libxl::Format* Importer::DateFormat(bool hasTime) {
+                libxl::Format*& format = hasTime ? dateTimeFormat : dateFormat;
+
+                if (!format) format = registry->DateFormat(book, hasTime);
+
+                return format;
+            }
+
+        }  // namespace
+
+        bool ParseExportOptions(Local<Value> value, libxl::Sheet* sheet,
+                                ExportOptions* options) {
+            Nan::HandleScope scope;
+
+            if (value->IsUndefined()) return cell_range::Parse(value, sheet, &options->range);
+
+            if (!value->IsObject()) {
+                Nan::ThrowTypeError("options must be an object");
+                return false;
+            }
+
+            Local<Object> object = value.As<Object>();
+            Local<Value> range;
+            std::optional<std::string> dateFormat;
+            std::optional<bool> useFormulaResults;
+
+            if (!options::GetProperty(object, keys::range, &range) ||
+                !cell_range::Parse(range, sheet, &options->range) ||
+                !GetChar(object, keys::delimiter, false, &options->delimiter) ||
+                !GetChar(object, keys::quote, true, &options->quote) ||
+                !options::GetString(object, keys::dateFormat, &dateFormat) ||
+                !options::GetBoolean(object, keys::useFormulaResults, &useFormulaResults)) {
+                return false;
+            }
+
+            if (dateFormat && *dateFormat != "iso" && *dateFormat != "number") {
+                Nan::ThrowTypeError("dateFormat must be 'iso' or 'number'");
+                return false;
+            }
+
+            if (options->delimiter == options->quote) {
+                Nan::ThrowTypeError("delimiter and quote must differ");
+                return false;
+            }
+
+            options->isoDates = !dateFormat || *dateFormat == "iso";
+            options->useFormulaResults = useFormulaResults.value_or(true);
+
+            return true;
+        }
+
+        bool Export(libxl::Book* book, libxl::Sheet* sheet, const ExportOptions& options, int fd,
+                    std::string* out, uint64_t* written, std::string* error) {
+            const CellRange& range = options.range;
+
+            *written = 0;
+
+            for (int row = range.rowFirst; row <= range.rowLast && !range.IsEmpty(); row++) {
+                for (int col = range.colFirst; col <= range.colLast; col++) {
+                    if (col > range.colFirst) out->push_back(options.delimiter);
+
+                    if (!AppendCell(out, book, sheet, row, col, options)) {
+                        const char* message = book->errorMessage();
+                        *error = message;
+                        return false;
+                    }
+                }
+
+                out->push_back('\n');
+
+                if (fd >= 0 && out->size() >= flushThreshold) {
+                    if (!WriteAll(fd, *out, error)) return false;
+
+                    *written += out->size();
+                    out->clear();
+                }
+            }
+
+            if (fd >= 0) {
+                if (!WriteAll(fd, *out, error)) return false;
+
+                *written += out->size();
+                out->clear();
+            } else {
+                *written = out->size();
+            }
+
+            return true;
+        }
+
+        bool ParseImportOptions(Local<Value> value, Book* book, ImportOptions* options) {
+            Nan::HandleScope scope;
+
+            if (value->IsUndefined()) return true;
+
+            if (!value->IsObject()) {
+                Nan::ThrowTypeError("options must be an object");
+                return false;
+            }
+
+            Local<Object> object = value.As<Object>();
+            std::optional<int> startRow, startCol;
+            std::optional<bool> inferTypes;
+            Local<Value> dateColumns, formats;
+
+            if (!options::GetInt(object, keys::startRow, &startRow) ||
+                !options::GetInt(object, keys::startCol, &startCol) ||
+                !GetChar(object, keys::delimiter, false, &options->delimiter) ||
+                !GetChar(object, keys::quote, true, &options->quote) ||
+                !options::GetBoolean(object, keys::inferTypes, &inferTypes) ||
+                !options::GetProperty(object, keys::dateColumns, &dateColumns) ||
+                !options::GetProperty(object, keys::formats, &formats)) {
+                return false;
+            }
+
+            if (startRow.value_or(0) < 0 || startCol.value_or(0) < 0) {
+                Nan::ThrowTypeError("startRow and startCol must not be negative");
+                return false;
+            }
+
+            if (options->delimiter == options->quote || options->delimiter == '\n' ||
+                options->delimiter == '\r') {
+                Nan::ThrowTypeError("invalid delimiter");
+                return false;
+            }
+
+            options->startRow = startRow.value_or(0);
+            options->startCol = startCol.value_or(0);
+            options->inferTypes = inferTypes.value_or(true);
+
+            if (!dateColumns->IsUndefined()) {
+                if (!dateColumns->IsArray()) {
+                    options::ThrowPropertyError("array", keys::dateColumns);
+                    return false;
+                }
+
+                Local<Array> array = dateColumns.As<Array>();
+
+                for (uint32_t i = 0; i < array->Length(); i++) {
+                    Local<Value> element;
+                    if (!Nan::Get(array, i).ToLocal(&element)) return false;
+
+                    int col = element->IsInt32() ? Nan::To<int32_t>(element).FromJust() : -1;
+
+                    if (col < 0) {
+                        options::ThrowPropertyError("array of column indices", keys::dateColumns);
+                        return false;
+                    }
+
+                    if (static_cast<size_t>(col) >= options->dateColumns.size()) {
+                        options->dateColumns.resize(col + 1);
+                    }
+
+                    options->dateColumns[col] = true;
+                }
+            }
+
+            if (!formats->IsUndefined()) {
+                if (!formats->IsArray()) {
+                    options::ThrowPropertyError("array", keys::formats);
+                    return false;
+                }
+
+                Local<Array> array = formats.As<Array>();
+
+                for (uint32_t i = 0; i < array->Length(); i++) {
+                    Local<Value> element;
+                    if (!Nan::Get(array, i).ToLocal(&element)) return false;
+
+                    Format* format = nullptr;
+
+                    if (!element->IsNullOrUndefined()) {
+                        format = Format::FromJS(element);
+
+                        if (!format) {
+                            options::ThrowPropertyError("array of formats", keys::formats);
+                            return false;
+                        }
+
+                        if (!util::IsSameBook(format, book)) {
+                            Nan::ThrowTypeError("parent books differ");
+                            return false;
+                        }
+                    }
+
+                    options->formats.push_back(format ? format->GetWrapped() : nullptr);
+                }
+            }
+
+            return true;
+        }
+
+        bool Import(libxl::Book* book, StyleRegistry* registry, libxl::Sheet* sheet,
+                    const ImportOptions& options, const char* data, size_t size, int* rows,
+                    std::string* error) {
+            Importer importer(book, registry, sheet, options);
+
+            if (!importer.Run(data, size, rows)) {
+                const char* message = book->errorMessage();
+                *error = message;
+
+                return false;
+            }
+
+            return true;
+        }
+
+    }  // namespace csv
+}  // namespace node_libxl
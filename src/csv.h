@@ -0,0 +1,91 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BINDINGS_CSV_H
+#define BINDINGS_CSV_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cell_range.h"
+#include "common.h"
+
+namespace node_libxl {
+
+    class Book;
+    class StyleRegistry;
+
+    namespace csv {
+
+        struct ExportOptions {
+            CellRange range;
+            char delimiter{','};
+            // 0 disables quoting
+            char quote{'"'};
+            // Dates as ISO 8601 strings instead of serial numbers
+            bool isoDates{true};
+            // Cached results instead of the formula text
+            bool useFormulaResults{true};
+        };
+
+        // Read {range, delimiter, quote, dateFormat: 'iso' | 'number', useFormulaResults}.
+        // Throws a TypeError and returns false if the options are malformed.
+        bool ParseExportOptions(v8::Local<v8::Value> value, libxl::Sheet* sheet,
+                                ExportOptions* options);
+
+        // Render the range as CSV into out. With fd >= 0 the output is written to the file
+        // descriptor in chunks as it is produced instead of being accumulated. Does not touch
+        // V8 and may run on a worker thread. On failure false is returned and error set.
+        bool Export(libxl::Book* book, libxl::Sheet* sheet, const ExportOptions& options, int fd,
+                    std::string* out, uint64_t* written, std::string* error);
+
+        struct ImportOptions {
+            int startRow{0};
+            int startCol{0};
+            char delimiter{','};
+            // 0 disables quoting
+            char quote{'"'};
+            // Write unquoted numbers, booleans and ISO dates as such instead of strings
+            bool inferTypes{true};
+            // Indexed by CSV column
+            std::vector<bool> dateColumns;
+            std::vector<libxl::Format*> formats;
+        };
+
+        // Read {startRow, startCol, delimiter, quote, inferTypes, dateColumns, formats}. Formats
+        // must belong to book. Throws a TypeError and returns false if the options are malformed.
+        bool ParseImportOptions(v8::Local<v8::Value> value, Book* book, ImportOptions* options);
+
+        // Parse CSV data (RFC 4180, LF, CRLF or CR line ends) and write it to the sheet. Dates
+        // without an explicit column format get a date format from the registry. Does not
+        // touch V8 and may run on a worker thread. On failure false is returned and error set.
+        bool Import(libxl::Book* book, StyleRegistry* registry, libxl::Sheet* sheet,
+                    const ImportOptions& options, const char* data, size_t size, int* rows,
+                    std::string* error);
+
+    }  // namespace csv
+}  // namespace node_libxl
+
+#endif  // BINDINGS_CSV_H
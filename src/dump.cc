@@ -0,0 +1,225 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "dump.h"
+
+#include <cstring>
+
+#include "keys.h"
+#include "options.h"
+#include "value_format.h"
+
+using namespace v8;
+
+namespace node_libxl {
+    namespace dump {
+
+        namespace {
+
+            void AppendInt(std::string* out, int value) { out->append(std::to_string(value)); }
+
+            void AppendQuad(std::string* out, int a, int b, int c, int d) {
+                out->push_back('[');
+                AppendInt(out, a);
+                out->push_back(',');
+                AppendInt(out, b);
+                out->push_back(',');
+                AppendInt(out, c);
+                out->push_back(',');
+                AppendInt(out, d);
+                out->push_back(']');
+            }
+
+            bool AppendCells(std::string* out, libxl::Book* book, libxl::Sheet* sheet,
+                             const Options& options, int rowFirst, int rowLast, int colFirst,
+                             int colLast) {
+                bool first = true;
+
+                for (int row = rowFirst; row <= rowLast; row++) {
+                    for (int col = colFirst; col <= colLast; col++) {
+                        bool formula = options.formulas && sheet->isFormula(row, col);
+                        size_t mark = out->size();
+                        bool written;
+
+                        if (!first) out->push_back(',');
+                        out->push_back('[');
+                        AppendInt(out, row);
+                        out->push_back(',');
+                        AppendInt(out, col);
+                        out->push_back(',');
+
+                        if (!value_format::AppendJsonValue(out, book, sheet, row, col,
+                                                           options.isoDates, &written)) {
+                            return false;
+                        }
+
+                        if (!written) {
+                            if (!formula) {
+                                out->resize(mark);
+                                continue;
+                            }
+
+                            out->append("null");
+                        }
+
+                        if (formula) {
+                            const char* text = sheet->readFormula(row, col);
+                            if (!text) return false;
+
+                            out->push_back(',');
+                            value_format::AppendJsonString(out, text, strlen(text));
+                        }
+
+                        out->push_back(']');
+                        first = false;
+                    }
+                }
+
+                return true;
+            }
+
+            bool AppendSheet(std::string* out, libxl::Book* book, int index,
+                             const Options& options) {
+                const char* name = book->getSheetName(index);
+                int type = book->sheetType(index);
+                libxl::Sheet* sheet = type == libxl::SHEETTYPE_SHEET ? book->getSheet(index)
+                                                                     : nullptr;
+
+                if (!name || (type == libxl::SHEETTYPE_SHEET && !sheet)) return false;
+
+                out->append("{\"name\":");
+                value_format::AppendJsonString(out, name, strlen(name));
+                out->append(",\"type\":");
+                AppendInt(out, type);
+
+                // Chart sheets only get their name and type
+                if (!sheet) {
+                    out->append(",\"hidden\":0,\"range\":null,\"merges\":[],\"cells\":[]}");
+                    return true;
+                }
+
+                // The last filled row / column point behind the filled area
+                int rowFirst = sheet->firstFilledRow(), rowLast = sheet->lastFilledRow();
+                int colFirst = sheet->firstFilledCol(), colLast = sheet->lastFilledCol();
+                int hidden = sheet->hidden();
+
+                rowLast--;
+                colLast--;
+
+                out->append(",\"hidden\":");
+                AppendInt(out, hidden);
+                out->append(",\"range\":");
+
+                if (rowLast < rowFirst || colLast < colFirst) {
+                    out->append("null");
+                } else {
+                    AppendQuad(out, rowFirst, rowLast, colFirst, colLast);
+                }
+
+                out->append(",\"merges\":[");
+
+                int merges = options.merges ? sheet->mergeSize() : 0;
+
+                for (int i = 0; i < merges; i++) {
+                    int mergeRowFirst, mergeRowLast, mergeColFirst, mergeColLast;
+
+                    if (!sheet->merge(i, &mergeRowFirst, &mergeRowLast, &mergeColFirst,
+                                      &mergeColLast)) {
+                        return false;
+                    }
+
+                    if (i > 0) out->push_back(',');
+                    AppendQuad(out, mergeRowFirst, mergeRowLast, mergeColFirst, mergeColLast);
+                }
+
+                out->append("],\"cells\":[");
+
+                if (!AppendCells(out, book, sheet, options, rowFirst, rowLast, colFirst,
+                                 colLast)) {
+                    return false;
+                }
+
+                out->append("]}");
+
+                return true;
+            }
+
+        }  // namespace
+
+        bool ParseOptions(Local<Value> value, Options* options) {
+            Nan::HandleScope scope;
+
+            if (value->IsUndefined()) return true;
+
+            if (!value->IsObject()) {
+                Nan::ThrowTypeError("options must be an object");
+                return false;
+            }
+
+            Local<Object> object = value.As<Object>();
+            std::optional<bool> formulas, merges;
+            std::optional<std::string> dates;
+
+            if (!options::GetBoolean(object, keys::formulas, &formulas) ||
+                !options::GetBoolean(object, keys::merges, &merges) ||
+                !options::GetString(object, keys::dates, &dates)) {
+                return false;
+            }
+
+            if (dates && *dates != "iso" && *dates != "epoch") {
+                Nan::ThrowTypeError("dates must be 'iso' or 'epoch'");
+                return false;
+            }
+
+            options->formulas = formulas.value_or(true);
+            options->merges = merges.value_or(true);
+            options->isoDates = !dates || *dates == "iso";
+
+            return true;
+        }
+
+        bool Build(libxl::Book* book, const Options& options, std::string* out,
+                   std::string* error) {
+            int count = book->sheetCount();
+
+            out->append("{\"sheets\":[");
+
+            for (int i = 0; i < count; i++) {
+                if (i > 0) out->push_back(',');
+
+                if (!AppendSheet(out, book, i, options)) {
+                    const char* message = book->errorMessage();
+                    *error = message;
+
+                    return false;
+                }
+            }
+
+            out->append("]}");
+
+            return true;
+        }
+
+    }  // namespace dump
+}  // namespace node_libxl
@@ -0,0 +1,60 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BINDINGS_DUMP_H
+#define BINDINGS_DUMP_H
+
+#include <string>
+
+#include "common.h"
+
+namespace node_libxl {
+    namespace dump {
+
+        struct Options {
+            bool formulas{true};
+            bool merges{true};
+            // Dates as ISO 8601 strings instead of milliseconds since the epoch
+            bool isoDates{true};
+        };
+
+        // Read {formulas, merges, dates: 'iso' | 'epoch'}. Throws a TypeError and returns false
+        // if the options are malformed.
+        bool ParseOptions(v8::Local<v8::Value> value, Options* options);
+
+        // Render every sheet of the book as JSON:
+        //
+        //   {"sheets": [{"name", "type", "hidden", "range", "merges", "cells"}, ...]}
+        //
+        // range is [rowFirst, rowLast, colFirst, colLast] of the filled cells (null for empty
+        // sheets), merges a list of such quadruples and cells a list of [row, col, value] or
+        // [row, col, value, formula] entries for all cells that are not blank. Does not touch
+        // V8 and may run on a worker thread. On failure false is returned and error set.
+        bool Build(libxl::Book* book, const Options& options, std::string* out,
+                   std::string* error);
+
+    }  // namespace dump
+}  // namespace node_libxl
+
+#endif  // BINDINGS_DUMP_H
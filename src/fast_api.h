@@ -0,0 +1,98 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BINDINGS_FAST_API_H
+#define BINDINGS_FAST_API_H
+
+#include <nan.h>
+#include <v8.h>
+
+// V8 can call simple accessors through its fast C function path from optimized code. The
+// bindings rely on FastApiCallbackOptions::fallback to hand errors to the regular (slow)
+// implementation, which limits this to V8 10.x - 12.4 (Node 18 - 22). Other versions
+// register the slow callback only.
+#if defined(__has_include)
+#if __has_include(<v8-fast-api-calls.h>)
+#if V8_MAJOR_VERSION >= 10 && \
+    (V8_MAJOR_VERSION < 12 || (V8_MAJOR_VERSION == 12 && V8_MINOR_VERSION <= 4))
+#define NODE_LIBXL_FAST_API
+#endif
+#endif
+#endif
+
+#ifdef NODE_LIBXL_FAST_API
+
+#include <v8-fast-api-calls.h>
+
+#include <cmath>
+#include <cstdint>
+
+namespace node_libxl {
+    namespace fast_api {
+
+        template <Nan::FunctionCallback Slow>
+        void SlowCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+            Slow(Nan::FunctionCallbackInfo<v8::Value>(info, v8::Local<v8::Value>()));
+        }
+
+        template <Nan::FunctionCallback Slow, auto Fast>
+        void SetPrototypeMethod(v8::Local<v8::FunctionTemplate> t, const char* name) {
+            // V8 keeps a pointer to the CFunction, so it has to be static
+            static const v8::CFunction cFunction = v8::CFunction::Make(Fast);
+
+            v8::Isolate* isolate = v8::Isolate::GetCurrent();
+            v8::Local<v8::String> methodName = Nan::New<v8::String>(name).ToLocalChecked();
+
+            v8::Local<v8::FunctionTemplate> method = v8::FunctionTemplate::New(
+                isolate, SlowCallback<Slow>, v8::Local<v8::Value>(), v8::Signature::New(isolate, t),
+                0, v8::ConstructorBehavior::kThrow, v8::SideEffectType::kHasSideEffect, &cFunction);
+
+            method->SetClassName(methodName);
+            t->PrototypeTemplate()->Set(methodName, method);
+        }
+
+        // Fast calls receive JS numbers as double; anything that ArgumentHelper::GetInt
+        // would reject is left to the slow path.
+        inline bool ToInt(double value, int* result) {
+            if (!(value >= INT32_MIN && value <= INT32_MAX) || std::trunc(value) != value) {
+                return false;
+            }
+
+            *result = static_cast<int>(value);
+            return true;
+        }
+
+    }  // namespace fast_api
+}  // namespace node_libxl
+
+#define SET_FAST_PROTOTYPE_METHOD(t, name, slow, fast) \
+    ::node_libxl::fast_api::SetPrototypeMethod<slow, fast>(t, name)
+
+#else
+
+#define SET_FAST_PROTOTYPE_METHOD(t, name, slow, fast) Nan::SetPrototypeMethod(t, name, slow)
+
+#endif  // NODE_LIBXL_FAST_API
+
+#endif  // BINDINGS_FAST_API_H
@@ -26,6 +26,7 @@
 
 #include "argument_helper.h"
 #include "assert.h"
+#include "keys.h"
 #include "util.h"
 
 using namespace v8;
@@ -136,9 +137,9 @@ namespace node_libxl {
         }
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("value").ToLocalChecked(), Nan::New<Number>(value));
-        Nan::Set(result, Nan::New<String>("top").ToLocalChecked(), Nan::New<Boolean>(top));
-        Nan::Set(result, Nan::New<String>("percent").ToLocalChecked(), Nan::New<Boolean>(percent));
+        Nan::Set(result, keys::Get(keys::value), Nan::New<Number>(value));
+        Nan::Set(result, keys::Get(keys::top), Nan::New<Boolean>(top));
+        Nan::Set(result, keys::Get(keys::percent), Nan::New<Boolean>(percent));
 
         info.GetReturnValue().Set(result);
     }
@@ -177,13 +178,11 @@ namespace node_libxl {
         }
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("op1").ToLocalChecked(), Nan::New<Number>(op1));
-        Nan::Set(result, Nan::New<String>("v1").ToLocalChecked(),
-                 Nan::New<String>(v1).ToLocalChecked());
-        Nan::Set(result, Nan::New<String>("op2").ToLocalChecked(), Nan::New<Number>(op2));
-        Nan::Set(result, Nan::New<String>("v2").ToLocalChecked(),
-                 Nan::New<String>(v2).ToLocalChecked());
-        Nan::Set(result, Nan::New<String>("andOp").ToLocalChecked(), Nan::New<Boolean>(andOp));
+        Nan::Set(result, keys::Get(keys::op1), Nan::New<Number>(op1));
+        Nan::Set(result, keys::Get(keys::v1), Nan::New<String>(v1).ToLocalChecked());
+        Nan::Set(result, keys::Get(keys::op2), Nan::New<Number>(op2));
+        Nan::Set(result, keys::Get(keys::v2), Nan::New<String>(v2).ToLocalChecked());
+        Nan::Set(result, keys::Get(keys::andOp), Nan::New<Boolean>(andOp));
 
         info.GetReturnValue().Set(result);
     }
@@ -250,6 +249,7 @@ namespace node_libxl {
 
         t->ReadOnlyPrototype();
         constructor.Reset(Nan::GetFunction(t).ToLocalChecked());
+        functionTemplate.Reset(t);
         Nan::Set(exports, Nan::New<String>("FilterColumn").ToLocalChecked(), Nan::New(constructor));
     }
 }  // namespace node_libxl
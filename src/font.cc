@@ -40,11 +40,15 @@ namespace node_libxl {
     Local<Object> Font::NewInstance(libxl::Font* libxlFont, Local<Value> book) {
         Nan::EscapableHandleScope scope;
 
+        Local<Object> that = Book::FromJS(book)->LookupWrapper(Book::WrapperKind::font, libxlFont);
+        if (!that.IsEmpty()) return scope.Escape(that);
+
         Font* font = new Font(libxlFont, book);
 
-        Local<Object> that = util::CallStubConstructor(Nan::New(constructor)).As<Object>();
+        that = util::CallStubConstructor(Nan::New(constructor)).As<Object>();
 
         font->Wrap(that);
+        font->RegisterIdentity(Book::WrapperKind::font, libxlFont, font);
 
         return scope.Escape(that);
     }
@@ -290,6 +294,7 @@ namespace node_libxl {
 
         t->ReadOnlyPrototype();
         constructor.Reset(Nan::GetFunction(t).ToLocalChecked());
+        functionTemplate.Reset(t);
         Nan::Set(exports, Nan::New<String>("Font").ToLocalChecked(), Nan::New(constructor));
     }
 
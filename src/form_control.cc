@@ -26,6 +26,7 @@
 
 #include "argument_helper.h"
 #include "assert.h"
+#include "keys.h"
 #include "util.h"
 
 using namespace v8;
@@ -683,10 +684,10 @@ namespace node_libxl {
         }
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("col").ToLocalChecked(), Nan::New<Number>(col));
-        Nan::Set(result, Nan::New<String>("colOff").ToLocalChecked(), Nan::New<Number>(colOff));
-        Nan::Set(result, Nan::New<String>("row").ToLocalChecked(), Nan::New<Number>(row));
-        Nan::Set(result, Nan::New<String>("rowOff").ToLocalChecked(), Nan::New<Number>(rowOff));
+        Nan::Set(result, keys::Get(keys::col), Nan::New<Number>(col));
+        Nan::Set(result, keys::Get(keys::colOff), Nan::New<Number>(colOff));
+        Nan::Set(result, keys::Get(keys::row), Nan::New<Number>(row));
+        Nan::Set(result, keys::Get(keys::rowOff), Nan::New<Number>(rowOff));
 
         info.GetReturnValue().Set(result);
     }
@@ -706,10 +707,10 @@ namespace node_libxl {
         }
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("col").ToLocalChecked(), Nan::New<Number>(col));
-        Nan::Set(result, Nan::New<String>("colOff").ToLocalChecked(), Nan::New<Number>(colOff));
-        Nan::Set(result, Nan::New<String>("row").ToLocalChecked(), Nan::New<Number>(row));
-        Nan::Set(result, Nan::New<String>("rowOff").ToLocalChecked(), Nan::New<Number>(rowOff));
+        Nan::Set(result, keys::Get(keys::col), Nan::New<Number>(col));
+        Nan::Set(result, keys::Get(keys::colOff), Nan::New<Number>(colOff));
+        Nan::Set(result, keys::Get(keys::row), Nan::New<Number>(row));
+        Nan::Set(result, keys::Get(keys::rowOff), Nan::New<Number>(rowOff));
 
         info.GetReturnValue().Set(result);
     }
@@ -775,6 +776,7 @@ namespace node_libxl {
 
         t->ReadOnlyPrototype();
         constructor.Reset(Nan::GetFunction(t).ToLocalChecked());
+        functionTemplate.Reset(t);
         Nan::Set(exports, Nan::New<String>("FormControl").ToLocalChecked(), Nan::New(constructor));
     }
 }  // namespace node_libxl
@@ -27,6 +27,7 @@
 #include "argument_helper.h"
 #include "assert.h"
 #include "font.h"
+#include "style_spec.h"
 #include "util.h"
 
 using namespace v8;
@@ -41,11 +42,16 @@ namespace node_libxl {
     Local<Object> Format::NewInstance(libxl::Format* libxlFormat, Local<Value> book) {
         Nan::EscapableHandleScope scope;
 
+        Local<Object> that =
+            Book::FromJS(book)->LookupWrapper(Book::WrapperKind::format, libxlFormat);
+        if (!that.IsEmpty()) return scope.Escape(that);
+
         Format* format = new Format(libxlFormat, book);
 
-        Local<Object> that = util::CallStubConstructor(Nan::New(constructor)).As<Object>();
+        that = util::CallStubConstructor(Nan::New(constructor)).As<Object>();
 
         format->Wrap(that);
+        format->RegisterIdentity(Book::WrapperKind::format, libxlFormat, format);
 
         return scope.Escape(that);
     }
@@ -698,6 +704,28 @@ namespace node_libxl {
         info.GetReturnValue().Set(info.This());
     }
 
+    NAN_METHOD(Format::Set) {
+        Nan::HandleScope scope;
+
+        FormatSpec spec;
+        if (!style_spec::Parse(info[0], &spec)) return;
+
+        Format* that = FromJS(info.This());
+        ASSERT_THIS(that);
+
+        if (spec.fontObject) {
+            ASSERT_SAME_BOOK(spec.fontObject, that);
+        }
+
+        libxl::Book* libxlBook = util::UnwrapBook(that);
+        if (!util::GetBook(that)->GetStyleRegistry().ResolveNumFormat(libxlBook, &spec) ||
+            !style_spec::Apply(spec, libxlBook, that->GetWrapped())) {
+            return util::ThrowLibxlError(that);
+        }
+
+        info.GetReturnValue().Set(info.This());
+    }
+
     // Init
 
     void Format::Initialize(Local<Object> exports) {
@@ -758,9 +786,11 @@ namespace node_libxl {
         Nan::SetPrototypeMethod(t, "setHidden", SetHidden);
         Nan::SetPrototypeMethod(t, "locked", Locked);
         Nan::SetPrototypeMethod(t, "setLocked", SetLocked);
+        Nan::SetPrototypeMethod(t, "set", Set);
 
         t->ReadOnlyPrototype();
         constructor.Reset(Nan::GetFunction(t).ToLocalChecked());
+        functionTemplate.Reset(t);
         Nan::Set(exports, Nan::New<String>("Format").ToLocalChecked(), Nan::New(constructor));
     }
 
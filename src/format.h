@@ -88,6 +88,7 @@ namespace node_libxl {
         static NAN_METHOD(SetLocked);
         static NAN_METHOD(Hidden);
         static NAN_METHOD(SetHidden);
+        static NAN_METHOD(Set);
 
        private:
         Format(const Format&);
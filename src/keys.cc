@@ -0,0 +1,163 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "keys.h"
+
+#include <nan.h>
+
+using namespace v8;
+
+namespace node_libxl {
+    namespace keys {
+
+        static const char* const names[] = {
+            "alignH",
+            "alignV",
+            "andOp",
+            "blanks",
+            "blue",
+            "bold",
+            "bookIndex",
+            "border",
+            "borderBottom",
+            "borderBottomColor",
+            "borderColor",
+            "borderDiagonal",
+            "borderDiagonalColor",
+            "borderLeft",
+            "borderLeftColor",
+            "borderRight",
+            "borderRightColor",
+            "borderTop",
+            "borderTopColor",
+            "capacity",
+            "col",
+            "colFirst",
+            "colLast",
+            "colLeft",
+            "colOff",
+            "color",
+            "colRelative",
+            "colRight",
+            "columnIndex",
+            "data",
+            "date",
+            "dateColumns",
+            "dateFormat",
+            "dates",
+            "day",
+            "delimiter",
+            "descending",
+            "dictionary",
+            "fillPattern",
+            "font",
+            "fonts",
+            "format",
+            "formats",
+            "formula",
+            "formulas",
+            "green",
+            "headerRow",
+            "hPages",
+            "height",
+            "hidden",
+            "hits",
+            "hour",
+            "hyperlink",
+            "indent",
+            "inferTypes",
+            "italic",
+            "linkPath",
+            "locked",
+            "merges",
+            "minute",
+            "misses",
+            "month",
+            "msecond",
+            "name",
+            "numFormat",
+            "offsets",
+            "offset_x",
+            "offset_y",
+            "op1",
+            "op2",
+            "patternBackgroundColor",
+            "patternForegroundColor",
+            "percent",
+            "quote",
+            "range",
+            "red",
+            "rotation",
+            "row",
+            "rowBottom",
+            "rowFirst",
+            "rowLast",
+            "rowOff",
+            "rowRelative",
+            "rowTop",
+            "scopeId",
+            "script",
+            "second",
+            "shrinkToFit",
+            "size",
+            "sizes",
+            "startCol",
+            "startRow",
+            "strikeOut",
+            "text",
+            "top",
+            "totalRowCount",
+            "type",
+            "types",
+            "underline",
+            "useFormulaResults",
+            "v1",
+            "v2",
+            "value",
+            "wPages",
+            "width",
+            "wrap",
+            "year",
+        };
+
+        static_assert(sizeof(names) / sizeof(names[0]) == KEY_COUNT, "key names out of sync");
+
+        static Nan::Persistent<String> strings[KEY_COUNT];
+
+        void Initialize() {
+            Nan::HandleScope scope;
+
+            Isolate* isolate = Isolate::GetCurrent();
+
+            for (int i = 0; i < KEY_COUNT; i++) {
+                strings[i].Reset(
+                    String::NewFromUtf8(isolate, names[i], NewStringType::kInternalized)
+                        .ToLocalChecked());
+            }
+        }
+
+        Local<String> Get(Key key) { return Nan::New(strings[key]); }
+
+    }  // namespace keys
+}  // namespace node_libxl
@@ -0,0 +1,154 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BINDINGS_KEYS_H
+#define BINDINGS_KEYS_H
+
+#include <v8.h>
+
+namespace node_libxl {
+    namespace keys {
+
+        // Property names of the result objects returned by the bindings. The strings are
+        // internalized once on startup instead of being created anew on every call.
+        enum Key {
+            alignH,
+            alignV,
+            andOp,
+            blanks,
+            blue,
+            bold,
+            bookIndex,
+            border,
+            borderBottom,
+            borderBottomColor,
+            borderColor,
+            borderDiagonal,
+            borderDiagonalColor,
+            borderLeft,
+            borderLeftColor,
+            borderRight,
+            borderRightColor,
+            borderTop,
+            borderTopColor,
+            capacity,
+            col,
+            colFirst,
+            colLast,
+            colLeft,
+            colOff,
+            color,
+            colRelative,
+            colRight,
+            columnIndex,
+            data,
+            date,
+            dateColumns,
+            dateFormat,
+            dates,
+            day,
+            delimiter,
+            descending,
+            dictionary,
+            fillPattern,
+            font,
+            fonts,
+            format,
+            formats,
+            formula,
+            formulas,
+            green,
+            headerRow,
+            hPages,
+            height,
+            hidden,
+            hits,
+            hour,
+            hyperlink,
+            indent,
+            inferTypes,
+            italic,
+            linkPath,
+            locked,
+            merges,
+            minute,
+            misses,
+            month,
+            msecond,
+            name,
+            numFormat,
+            offsets,
+            offset_x,
+            offset_y,
+            op1,
+            op2,
+            patternBackgroundColor,
+            patternForegroundColor,
+            percent,
+            quote,
+            range,
+            red,
+            rotation,
+            row,
+            rowBottom,
+            rowFirst,
+            rowLast,
+            rowOff,
+            rowRelative,
+            rowTop,
+            scopeId,
+            script,
+            second,
+            shrinkToFit,
+            size,
+            sizes,
+            startCol,
+            startRow,
+            strikeOut,
+            text,
+            top,
+            totalRowCount,
+            type,
+            types,
+            underline,
+            useFormulaResults,
+            v1,
+            v2,
+            value,
+            wPages,
+            width,
+            wrap,
+            year,
+
+            KEY_COUNT
+        };
+
+        void Initialize();
+
+        v8::Local<v8::String> Get(Key key);
+
+    }  // namespace keys
+}  // namespace node_libxl
+
+#endif  // BINDINGS_KEYS_H
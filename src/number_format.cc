@@ -0,0 +1,1183 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "number_format.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "value_format.h"
+
+namespace node_libxl {
+
+    namespace {
+
+        // Excel's codes for the built-in formats libxl knows about
+        const char* BuiltinCode(int id) {
+            switch (id) {
+                case libxl::NUMFORMAT_GENERAL:
+                    return "General";
+                case libxl::NUMFORMAT_NUMBER:
+                    return "0";
+                case libxl::NUMFORMAT_NUMBER_D2:
+                    return "0.00";
+                case libxl::NUMFORMAT_NUMBER_SEP:
+                    return "#,##0";
+                case libxl::NUMFORMAT_NUMBER_SEP_D2:
+                    return "#,##0.00";
+                case libxl::NUMFORMAT_CURRENCY_NEGBRA:
+                    return "\"$\"#,##0_);(\"$\"#,##0)";
+                case libxl::NUMFORMAT_CURRENCY_NEGBRARED:
+                    return "\"$\"#,##0_);[Red](\"$\"#,##0)";
+                case libxl::NUMFORMAT_CURRENCY_D2_NEGBRA:
+                    return "\"$\"#,##0.00_);(\"$\"#,##0.00)";
+                case libxl::NUMFORMAT_CURRENCY_D2_NEGBRARED:
+                    return "\"$\"#,##0.00_);[Red](\"$\"#,##0.00)";
+                case libxl::NUMFORMAT_PERCENT:
+                    return "0%";
+                case libxl::NUMFORMAT_PERCENT_D2:
+                    return "0.00%";
+                case libxl::NUMFORMAT_SCIENTIFIC_D2:
+                    return "0.00E+00";
+                case libxl::NUMFORMAT_FRACTION_ONEDIG:
+                    return "# ?/?";
+                case libxl::NUMFORMAT_FRACTION_TWODIG:
+                    return "# ?\?/??";
+                case libxl::NUMFORMAT_DATE:
+                    return "m/d/yyyy";
+                case libxl::NUMFORMAT_CUSTOM_D_MON_YY:
+                    return "d-mmm-yy";
+                case libxl::NUMFORMAT_CUSTOM_D_MON:
+                    return "d-mmm";
+                case libxl::NUMFORMAT_CUSTOM_MON_YY:
+                    return "mmm-yy";
+                case libxl::NUMFORMAT_CUSTOM_HMM_AM:
+                    return "h:mm AM/PM";
+                case libxl::NUMFORMAT_CUSTOM_HMMSS_AM:
+                    return "h:mm:ss AM/PM";
+                case libxl::NUMFORMAT_CUSTOM_HMM:
+                    return "h:mm";
+                case libxl::NUMFORMAT_CUSTOM_HMMSS:
+                    return "h:mm:ss";
+                case libxl::NUMFORMAT_CUSTOM_MDYYYY_HMM:
+                    return "m/d/yyyy h:mm";
+                case libxl::NUMFORMAT_NUMBER_SEP_NEGBRA:
+                    return "#,##0_);(#,##0)";
+                case libxl::NUMFORMAT_NUMBER_SEP_NEGBRARED:
+                    return "#,##0_);[Red](#,##0)";
+                case libxl::NUMFORMAT_NUMBER_D2_SEP_NEGBRA:
+                    return "#,##0.00_);(#,##0.00)";
+                case libxl::NUMFORMAT_NUMBER_D2_SEP_NEGBRARED:
+                    return "#,##0.00_);[Red](#,##0.00)";
+                case libxl::NUMFORMAT_ACCOUNT:
+                    return "_(* #,##0_);_(* (#,##0);_(* \"-\"_);_(@_)";
+                case libxl::NUMFORMAT_ACCOUNTCUR:
+                    return "_(\"$\"* #,##0_);_(\"$\"* (#,##0);_(\"$\"* \"-\"_);_(@_)";
+                case libxl::NUMFORMAT_ACCOUNT_D2:
+                    return "_(* #,##0.00_);_(* (#,##0.00);_(* \"-\"??_);_(@_)";
+                case libxl::NUMFORMAT_ACCOUNT_D2_CUR:
+                    return "_(\"$\"* #,##0.00_);_(\"$\"* (#,##0.00);_(\"$\"* \"-\"??_);_(@_)";
+                case libxl::NUMFORMAT_CUSTOM_MMSS:
+                    return "mm:ss";
+                case libxl::NUMFORMAT_CUSTOM_H0MMSS:
+                    return "[h]:mm:ss";
+                case libxl::NUMFORMAT_CUSTOM_MMSS0:
+                    return "mm:ss.0";
+                case libxl::NUMFORMAT_CUSTOM_000P0E_PLUS0:
+                    return "##0.0E+0";
+                case libxl::NUMFORMAT_TEXT:
+                    return "@";
+                default:
+                    return "General";
+            }
+        }
+
+        const char* monthNames[] = {"January", "February", "March",     "April",
+                                    "May",     "June",     "July",      "August",
+                                    "September", "October", "November", "December"};
+
+        const char* dayNames[] = {"Sunday",   "Monday", "Tuesday", "Wednesday",
+                                  "Thursday", "Friday", "Saturday"};
+
+        // Decimal digits of value (>= 0) rounded half up to decimals places. Like Excel, only
+        // the first 15 significant digits are taken into account. integer has no leading
+        // zeros (and is empty for values below 1), fraction holds exactly decimals digits.
+        void RoundDecimal(double value, int decimals, std::string* integer,
+                          std::string* fraction) {
+            integer->clear();
+            fraction->assign(decimals, '0');
+
+            if (!(value > 0) || !std::isfinite(value)) return;
+
+            char buffer[32];
+            snprintf(buffer, sizeof(buffer), "%.14e", value);
+
+            // digits[i] has the weight 10^(exponent - i)
+            std::string digits(1, buffer[0]);
+            digits.append(buffer + 2, 14);
+            int exponent = atoi(strchr(buffer, 'e') + 1);
+            int keep = exponent + 1 + decimals;
+
+            if (keep < 0) return;
+
+            if (keep < static_cast<int>(digits.size())) {
+                bool up = digits[keep] >= '5';
+                digits.resize(keep);
+
+                if (up) {
+                    int i = keep - 1;
+                    for (; i >= 0 && digits[i] == '9'; i--) digits[i] = '0';
+
+                    if (i >= 0) {
+                        digits[i]++;
+                    } else {
+                        digits.insert(digits.begin(), '1');
+                        exponent++;
+                    }
+                }
+            }
+
+            int length = digits.size();
+
+            for (int i = 0; i <= exponent; i++) integer->push_back(i < length ? digits[i] : '0');
+
+            for (int i = 0; i < decimals; i++) {
+                int position = exponent + 1 + i;
+                if (position >= 0 && position < length) (*fraction)[i] = digits[position];
+            }
+        }
+
+        // Decimal exponent of value (> 0) after rounding to 15 significant digits
+        int Exponent(double value) {
+            char buffer[32];
+            snprintf(buffer, sizeof(buffer), "%.14e", value);
+
+            return atoi(strchr(buffer, 'e') + 1);
+        }
+
+        void StripZeros(std::string* digits) {
+            while (!digits->empty() && digits->back() == '0') digits->pop_back();
+        }
+
+        void AppendPadded(std::string* out, int64_t value, int width) {
+            std::string digits = std::to_string(value);
+
+            if (static_cast<int>(digits.size()) < width) out->append(width - digits.size(), '0');
+            out->append(digits);
+        }
+
+        // Excel's General format: up to 11 characters, scientific notation for very large and
+        // very small values
+        void AppendGeneral(std::string* out, double value) {
+            if (value < 0) {
+                out->push_back('-');
+                value = -value;
+            }
+
+            if (value == 0) {
+                out->push_back('0');
+                return;
+            }
+
+            int exponent = Exponent(value);
+            std::string integer, fraction;
+
+            if (exponent > -5 && exponent < 11) {
+                RoundDecimal(value, exponent >= 0 ? std::max(0, 9 - exponent) : 9, &integer,
+                             &fraction);
+                StripZeros(&fraction);
+
+                out->append(integer.empty() ? "0" : integer);
+                if (!fraction.empty()) out->append(".").append(fraction);
+
+                return;
+            }
+
+            RoundDecimal(value / std::pow(10., exponent), 5, &integer, &fraction);
+
+            if (integer.size() > 1) {
+                exponent++;
+                RoundDecimal(value / std::pow(10., exponent), 5, &integer, &fraction);
+            }
+
+            StripZeros(&fraction);
+
+            out->append(integer);
+            if (!fraction.empty()) out->append(".").append(fraction);
+            out->append(exponent < 0 ? "E-" : "E+");
+            AppendPadded(out, std::abs(exponent), 2);
+        }
+
+        // Closest fraction to value with a denominator of at most maxDenominator, via the
+        // continued fraction expansion and its best semiconvergent
+        void Approximate(double value, int64_t maxDenominator, int64_t* numerator,
+                         int64_t* denominator) {
+            int64_t p0 = 0, q0 = 1, p1 = 1, q1 = 0;
+            double rest = value;
+
+            for (int i = 0; i < 64; i++) {
+                double whole = std::floor(rest);
+                if (whole > 1e15) break;
+
+                int64_t a = static_cast<int64_t>(whole);
+                int64_t p2 = p0 + a * p1, q2 = q0 + a * q1;
+
+                if (q2 > maxDenominator) {
+                    int64_t k = (maxDenominator - q0) / q1;
+                    int64_t p = p0 + k * p1, q = q0 + k * q1;
+
+                    if (std::fabs(value - static_cast<double>(p) / q) <
+                        std::fabs(value - static_cast<double>(p1) / q1)) {
+                        p1 = p;
+                        q1 = q;
+                    }
+
+                    break;
+                }
+
+                p0 = p1;
+                q0 = q1;
+                p1 = p2;
+                q1 = q2;
+
+                if (rest - whole < 1e-12) break;
+                rest = 1 / (rest - whole);
+            }
+
+            *numerator = p1;
+            *denominator = q1;
+        }
+
+        bool StartsWith(const std::string& text, size_t pos, const char* prefix) {
+            size_t length = strlen(prefix);
+            if (text.size() - pos < length) return false;
+
+            for (size_t i = 0; i < length; i++) {
+                if (tolower(static_cast<unsigned char>(text[pos + i])) != prefix[i]) return false;
+            }
+
+            return true;
+        }
+
+    }  // namespace
+
+    struct NumberFormat::Token {
+        enum Type {
+            literal,
+            digit,
+            point,
+            comma,
+            exponent,
+            bar,
+            denominator,
+            at,  // @
+            general,
+            year,
+            month,
+            day,
+            hour,
+            minute,
+            second,
+            subsecond,
+            ampm,
+            elapsedHours,
+            elapsedMinutes,
+            elapsedSeconds
+        };
+
+        // Part of the number a digit placeholder belongs to
+        enum Part { integer, decimal, exponentDigits, numerator, denominatorDigits };
+
+        Type type;
+        Part part{integer};
+        // '0', '#' or '?' for digits, '+' or '-' for exponents
+        char placeholder{0};
+        // Run length of date and time parts
+        int width{0};
+        // Literal text; AM and PM text of ampm tokens; E or e of exponents
+        std::string text;
+        std::string alternate;
+
+        bool IsDate() const { return type >= year; }
+    };
+
+    struct NumberFormat::Section {
+        enum Kind { number, date, text };
+
+        std::vector<Token> tokens;
+        Kind kind{number};
+
+        // Explicit condition like [>=100]
+        std::string condition;
+        double operand{0};
+
+        bool grouping{false};
+        // Number of trailing commas, each dividing by 1000
+        int scale{0};
+        // Number of percent signs, each multiplying by 100
+        int percent{0};
+        bool exponent{false};
+        bool fraction{false};
+        int64_t fixedDenominator{0};
+        int subsecondDigits{0};
+        bool twelveHours{false};
+
+        bool Matches(double value) const {
+            if (condition == "<") return value < operand;
+            if (condition == "<=") return value <= operand;
+            if (condition == ">") return value > operand;
+            if (condition == ">=") return value >= operand;
+            if (condition == "=") return value == operand;
+            if (condition == "<>") return value != operand;
+
+            return true;
+        }
+
+        std::vector<size_t> Digits(Token::Part part) const {
+            std::vector<size_t> indices;
+
+            for (size_t i = 0; i < tokens.size(); i++) {
+                if (tokens[i].type == Token::digit && tokens[i].part == part) indices.push_back(i);
+            }
+
+            return indices;
+        }
+    };
+
+    NumberFormat::NumberFormat(const std::string& code) : code(code) { Compile(); }
+
+    NumberFormat::~NumberFormat() = default;
+
+    void NumberFormat::Compile() {
+        std::string current;
+        bool quoted = false;
+
+        // Split into sections at top level semicolons
+        for (size_t i = 0; i < code.size(); i++) {
+            char c = code[i];
+
+            if (quoted) {
+                quoted = c != '"';
+            } else if (c == '"') {
+                quoted = true;
+            } else if ((c == '\\' || c == '_' || c == '*') && i + 1 < code.size()) {
+                current.push_back(c);
+                c = code[++i];
+            } else if (c == '[') {
+                size_t end = code.find(']', i);
+
+                if (end != std::string::npos) {
+                    current.append(code, i, end - i + 1);
+                    i = end;
+                    continue;
+                }
+            } else if (c == ';') {
+                Parse(current, &sections.emplace_back());
+                current.clear();
+                continue;
+            }
+
+            current.push_back(c);
+        }
+
+        Parse(current, &sections.emplace_back());
+
+        if (sections.size() > 4) sections.resize(4);
+
+        if (sections.size() == 4) {
+            textSection = 3;
+        } else if (sections.back().kind == Section::text) {
+            textSection = sections.size() - 1;
+        }
+    }
+
+    void NumberFormat::Parse(const std::string& text, Section* section) {
+        std::vector<Token>& tokens = section->tokens;
+        bool hasDate = false, hasDigit = false, hasPoint = false;
+
+        auto literal = [&](const std::string& value) {
+            if (!tokens.empty() && tokens.back().type == Token::literal) {
+                tokens.back().text.append(value);
+            } else {
+                Token& token = tokens.emplace_back();
+                token.type = Token::literal;
+                token.text = value;
+            }
+        };
+
+        auto add = [&](Token::Type type, int width = 0) -> Token& {
+            Token& token = tokens.emplace_back();
+            token.type = type;
+            token.width = width;
+            hasDate = hasDate || token.IsDate();
+
+            return token;
+        };
+
+        // Length of the run of c (case insensitive) at pos
+        auto run = [&](size_t pos, char c) {
+            size_t end = pos;
+            while (end < text.size() && tolower(static_cast<unsigned char>(text[end])) == c) end++;
+            return static_cast<int>(end - pos);
+        };
+
+        for (size_t i = 0; i < text.size();) {
+            char c = text[i];
+            char lower = tolower(static_cast<unsigned char>(c));
+
+            if (c == '"') {
+                size_t end = text.find('"', i + 1);
+                if (end == std::string::npos) end = text.size();
+
+                literal(text.substr(i + 1, end - i - 1));
+                i = end + 1;
+            } else if (c == '\\' || c == '_' || c == '*') {
+                // Escaped character, padding with the width of a character, fill character
+                if (c == '\\' && i + 1 < text.size()) literal(text.substr(i + 1, 1));
+                if (c == '_') literal(" ");
+
+                i += 2;
+            } else if (c == '[') {
+                size_t end = text.find(']', i);
+
+                if (end == std::string::npos) {
+                    literal(text.substr(i));
+                    break;
+                }
+
+                std::string content = text.substr(i + 1, end - i - 1);
+                char first = content.empty() ? 0 : tolower(static_cast<unsigned char>(content[0]));
+                i = end + 1;
+
+                if (first == '$') {
+                    // Currency symbol and locale, [$€-407]
+                    literal(content.substr(1, content.find('-') - 1));
+                } else if ((first == 'h' || first == 'm' || first == 's') &&
+                           run(end - content.size(), first) == static_cast<int>(content.size())) {
+                    add(first == 'h'   ? Token::elapsedHours
+                        : first == 'm' ? Token::elapsedMinutes
+                                       : Token::elapsedSeconds,
+                        content.size());
+                } else if (first == '<' || first == '>' || first == '=') {
+                    size_t length = content.find_first_not_of("<>=");
+                    section->condition = content.substr(0, length);
+                    section->operand = strtod(content.c_str() + length, nullptr);
+                }
+
+                // Colors and other modifiers do not change the text
+            } else if (c == '0' || c == '#' || c == '?') {
+                Token& token = add(Token::digit);
+                token.placeholder = c;
+                hasDigit = true;
+                i++;
+            } else if (c == '.') {
+                int zeros = i + 1 < text.size() ? run(i + 1, '0') : 0;
+
+                if (hasDate && zeros > 0) {
+                    add(Token::subsecond, std::min(zeros, 3));
+                    i += 1 + zeros;
+                } else if (!hasDate && !hasPoint) {
+                    add(Token::point);
+                    hasPoint = true;
+                    i++;
+                } else {
+                    literal(".");
+                    i++;
+                }
+            } else if (c == ',' && !hasDate) {
+                add(Token::comma);
+                i++;
+            } else if (c == '%') {
+                literal("%");
+                section->percent++;
+                i++;
+            } else if (lower == 'e' && i + 1 < text.size() &&
+                       (text[i + 1] == '+' || text[i + 1] == '-')) {
+                Token& token = add(Token::exponent);
+                token.text = std::string(1, c);
+                token.placeholder = text[i + 1];
+                section->exponent = true;
+                i += 2;
+            } else if (c == '/' && hasDigit && !hasDate && !section->fraction) {
+                add(Token::bar);
+                section->fraction = true;
+                i++;
+
+                // Fixed denominator, # ?/8
+                size_t end = i;
+                while (end < text.size() && isdigit(static_cast<unsigned char>(text[end]))) end++;
+
+                if (end > i && text[i] != '0') {
+                    add(Token::denominator).text = text.substr(i, end - i);
+                    section->fixedDenominator = strtoll(text.c_str() + i, nullptr, 10);
+                    i = end;
+                }
+            } else if (c == '@') {
+                add(Token::at);
+                i++;
+            } else if (StartsWith(text, i, "general")) {
+                add(Token::general);
+                hasDigit = true;
+                i += 7;
+            } else if (StartsWith(text, i, "am/pm") || StartsWith(text, i, "a/p")) {
+                bool full = StartsWith(text, i, "am/pm");
+                Token& token = add(Token::ampm);
+
+                token.text = full ? "AM" : text.substr(i, 1);
+                token.alternate = full ? "PM" : text.substr(i + 2, 1);
+                section->twelveHours = true;
+                i += full ? 5 : 3;
+            } else if (lower == 'y' || lower == 'm' || lower == 'd' || lower == 'h' ||
+                       lower == 's') {
+                int width = run(i, lower);
+
+                add(lower == 'y'   ? Token::year
+                    : lower == 'm' ? Token::month
+                    : lower == 'd' ? Token::day
+                    : lower == 'h' ? Token::hour
+                                   : Token::second,
+                    width);
+                i += width;
+            } else {
+                literal(text.substr(i, 1));
+                i++;
+            }
+        }
+
+        Finish(section);
+    }
+
+    void NumberFormat::Finish(Section* section) {
+        std::vector<Token>& tokens = section->tokens;
+        bool hasDate = false, hasDigit = false, hasText = false;
+
+        for (const Token& token : tokens) {
+            hasDate = hasDate || token.IsDate();
+            hasDigit = hasDigit || token.type == Token::digit || token.type == Token::general;
+            hasText = hasText || token.type == Token::at;
+        }
+
+        if (hasDate) {
+            section->kind = Section::date;
+
+            // m is a minute right after hours or right before seconds
+            for (size_t i = 0; i < tokens.size(); i++) {
+                if (tokens[i].type != Token::month) continue;
+
+                Token::Type before = Token::literal, after = Token::literal;
+
+                for (size_t j = i; j-- > 0 && before == Token::literal;) {
+                    if (tokens[j].IsDate()) before = tokens[j].type;
+                }
+
+                for (size_t j = i + 1; j < tokens.size() && after == Token::literal; j++) {
+                    if (tokens[j].IsDate()) after = tokens[j].type;
+                }
+
+                if (before == Token::hour || before == Token::elapsedHours ||
+                    after == Token::second || after == Token::elapsedSeconds) {
+                    tokens[i].type = Token::minute;
+                }
+            }
+
+            for (const Token& token : tokens) {
+                if (token.type == Token::subsecond) {
+                    section->subsecondDigits = std::max(section->subsecondDigits, token.width);
+                }
+            }
+
+            return;
+        }
+
+        if (hasText && !hasDigit) {
+            section->kind = Section::text;
+            return;
+        }
+
+        // Commas between digits group thousands, trailing commas scale by 1000
+        bool seenDigit = false;
+
+        for (size_t i = 0; i < tokens.size(); i++) {
+            if (tokens[i].type == Token::digit) seenDigit = true;
+            if (tokens[i].type != Token::comma) continue;
+
+            size_t next = i;
+            while (next < tokens.size() && tokens[next].type == Token::comma) next++;
+
+            if (seenDigit && next < tokens.size() && tokens[next].type == Token::digit) {
+                section->grouping = true;
+            } else if (seenDigit) {
+                section->scale++;
+            } else {
+                tokens[i].type = Token::literal;
+                tokens[i].text = ",";
+                continue;
+            }
+
+            tokens.erase(tokens.begin() + i--);
+        }
+
+        Token::Part part = Token::integer;
+
+        for (size_t i = 0; i < tokens.size(); i++) {
+            Token& token = tokens[i];
+
+            if (token.type == Token::point && part == Token::integer) {
+                part = Token::decimal;
+            } else if (token.type == Token::exponent) {
+                part = Token::exponentDigits;
+            } else if (token.type == Token::bar) {
+                // The numerator is the run of digits right before the bar
+                for (size_t j = i; j-- > 0 && tokens[j].type == Token::digit;) {
+                    tokens[j].part = Token::numerator;
+                }
+
+                part = Token::denominatorDigits;
+            } else if (token.type == Token::digit) {
+                token.part = part;
+            }
+        }
+    }
+
+    const NumberFormat::Section& NumberFormat::Pick(double value, bool* minus) const {
+        size_t count = textSection >= 0 ? textSection : sections.size();
+        bool explicitConditions = false;
+
+        for (size_t i = 0; i < count; i++) {
+            explicitConditions = explicitConditions || !sections[i].condition.empty();
+        }
+
+        *minus = value < 0;
+
+        for (size_t i = 0; i + 1 < count && i < 2; i++) {
+            const Section& section = sections[i];
+            bool matches;
+
+            if (!section.condition.empty() || explicitConditions) {
+                matches = section.Matches(value);
+            } else if (i == 0) {
+                matches = count == 2 ? value >= 0 : value > 0;
+            } else {
+                matches = value < 0;
+            }
+
+            if (!matches) continue;
+
+            // The default negative section brings its own sign
+            if (i == 1 && section.condition.empty()) *minus = false;
+
+            return section;
+        }
+
+        const Section& last = sections[count - 1];
+        if (count == 2 && last.condition.empty() && !explicitConditions) *minus = false;
+
+        return last;
+    }
+
+    void NumberFormat::RenderNumber(libxl::Book* book, double value, std::string* out) const {
+        if (!std::isfinite(value)) {
+            out->append("#NUM!");
+            return;
+        }
+
+        size_t count = textSection >= 0 ? textSection : sections.size();
+
+        if (count == 0) {
+            AppendGeneral(out, value);
+            return;
+        }
+
+        bool minus;
+        const Section& section = Pick(value, &minus);
+
+        switch (section.kind) {
+            case Section::date:
+                RenderDate(section, book, value, out);
+                break;
+
+            case Section::text:
+                AppendGeneral(out, value);
+                break;
+
+            default: {
+                double scaled = std::fabs(value) * std::pow(100., section.percent) /
+                                std::pow(1000., section.scale);
+
+                if (minus) out->push_back('-');
+                RenderDigits(section, scaled, out);
+                break;
+            }
+        }
+    }
+
+    void NumberFormat::RenderText(const char* text, std::string* out) const {
+        if (textSection < 0) {
+            out->append(text);
+            return;
+        }
+
+        for (const Token& token : sections[textSection].tokens) {
+            if (token.type == Token::literal) out->append(token.text);
+            if (token.type == Token::at) out->append(text);
+        }
+    }
+
+    namespace {
+
+        char Fill(char placeholder) {
+            switch (placeholder) {
+                case '0':
+                    return '0';
+                case '?':
+                    return ' ';
+                default:
+                    return 0;
+            }
+        }
+
+        // Right aligned digits (digits has no leading zeros) in the given placeholders. The
+        // first placeholder takes all digits that do not fit.
+        void FillRight(const std::string& digits, const std::vector<char>& placeholders,
+                       bool grouping, std::vector<std::string>* slots) {
+            int count = placeholders.size(), length = digits.size();
+
+            auto append = [&](std::string* slot, char c, int position) {
+                slot->push_back(c);
+                if (grouping && c != ' ' && position > 0 && position % 3 == 0) {
+                    slot->push_back(',');
+                }
+            };
+
+            slots->assign(count, std::string());
+
+            for (int i = 0; i < count; i++) {
+                std::string& slot = (*slots)[i];
+                int position = count - 1 - i;
+
+                if (i == 0) {
+                    for (int j = 0; j < length - count; j++) {
+                        append(&slot, digits[j], length - 1 - j);
+                    }
+                }
+
+                if (position < length) {
+                    append(&slot, digits[length - 1 - position], position);
+                } else if (char fill = Fill(placeholders[i])) {
+                    append(&slot, fill, position);
+                }
+            }
+        }
+
+        // Left aligned digits in the given placeholders; trailing zeros are dropped for # and
+        // blanked for ?. The last placeholder takes all digits that do not fit.
+        void FillLeft(const std::string& digits, const std::vector<char>& placeholders,
+                      bool trimZeros, std::vector<std::string>* slots) {
+            int count = placeholders.size(), length = digits.size();
+            bool trailing = trimZeros;
+
+            slots->assign(count, std::string());
+
+            for (int i = count - 1; i >= 0; i--) {
+                std::string& slot = (*slots)[i];
+
+                if (i == count - 1 && length > count) slot = digits.substr(count);
+
+                if (i >= length || (trailing && digits[i] == '0' && placeholders[i] != '0')) {
+                    if (char fill = Fill(placeholders[i])) slot.insert(slot.begin(), fill);
+                    continue;
+                }
+
+                trailing = false;
+                slot.insert(slot.begin(), digits[i]);
+            }
+        }
+
+        std::vector<char> Placeholders(const std::vector<size_t>& indices,
+                                       const std::vector<char>& all) {
+            std::vector<char> result;
+            for (size_t index : indices) result.push_back(all[index]);
+            return result;
+        }
+
+    }  // namespace
+
+    void NumberFormat::RenderDigits(const Section& section, double value, std::string* out) const {
+        const std::vector<Token>& tokens = section.tokens;
+        std::vector<std::string> slots(tokens.size());
+        std::vector<char> all(tokens.size());
+
+        for (size_t i = 0; i < tokens.size(); i++) all[i] = tokens[i].placeholder;
+
+        auto fill = [&](Token::Part part, const std::string& digits, bool right, bool grouping,
+                        bool trimZeros) {
+            std::vector<size_t> indices = section.Digits(part);
+            std::vector<std::string> filled;
+            std::vector<char> placeholders = Placeholders(indices, all);
+
+            if (right) {
+                FillRight(digits, placeholders, grouping, &filled);
+            } else {
+                FillLeft(digits, placeholders, trimZeros, &filled);
+            }
+
+            for (size_t i = 0; i < indices.size(); i++) slots[indices[i]] = filled[i];
+
+            return indices.size();
+        };
+
+        std::string integer, fraction, exponentText, barText = "/", denominatorText;
+        size_t decimals = section.Digits(Token::decimal).size();
+
+        if (section.exponent) {
+            std::vector<size_t> integerDigits = section.Digits(Token::integer);
+            int width = std::max<int>(1, integerDigits.size());
+            bool engineering = false;
+            int exponent = 0;
+
+            for (size_t index : integerDigits) engineering |= width > 1 && all[index] == '#';
+
+            if (value > 0) {
+                int magnitude = Exponent(value);
+
+                exponent = engineering
+                               ? (magnitude >= 0 ? magnitude : magnitude - width + 1) / width *
+                                     width
+                               : magnitude - (width - 1);
+                RoundDecimal(value / std::pow(10., exponent), decimals, &integer, &fraction);
+
+                if (static_cast<int>(integer.size()) > width) {
+                    exponent += engineering ? width : 1;
+                    RoundDecimal(value / std::pow(10., exponent), decimals, &integer, &fraction);
+                }
+            } else {
+                fraction.assign(decimals, '0');
+            }
+
+            fill(Token::integer, integer, true, section.grouping, false);
+            fill(Token::decimal, fraction, false, false, true);
+            fill(Token::exponentDigits, std::to_string(std::abs(exponent)), true, false, false);
+
+            exponentText = exponent < 0 ? "-" : "+";
+        } else if (section.fraction) {
+            bool hasInteger = !section.Digits(Token::integer).empty();
+            double whole = hasInteger ? std::floor(value) : 0;
+            int64_t numerator, denominator;
+
+            if (section.fixedDenominator > 0) {
+                denominator = section.fixedDenominator;
+                numerator = std::llround((value - whole) * denominator);
+            } else {
+                int64_t maxDenominator = 1;
+                for (size_t i = section.Digits(Token::denominatorDigits).size(); i > 0; i--) {
+                    maxDenominator *= 10;
+                }
+
+                Approximate(value - whole, std::max<int64_t>(maxDenominator - 1, 1), &numerator,
+                            &denominator);
+            }
+
+            if (hasInteger && numerator == denominator) {
+                whole++;
+                numerator = 0;
+            }
+
+            RoundDecimal(whole, 0, &integer, &fraction);
+
+            if (hasInteger && numerator == 0) {
+                // Only the whole number is shown, the fraction is blanked out
+                if (integer.empty()) integer = "0";
+
+                fill(Token::integer, integer, true, section.grouping, false);
+                barText = " ";
+
+                for (size_t index : section.Digits(Token::numerator)) slots[index] = " ";
+                for (size_t index : section.Digits(Token::denominatorDigits)) slots[index] = " ";
+
+                for (const Token& token : tokens) {
+                    if (token.type == Token::denominator) {
+                        denominatorText.assign(token.text.size(), ' ');
+                    }
+                }
+            } else {
+                fill(Token::integer, integer, true, section.grouping, false);
+                fill(Token::numerator, std::to_string(numerator), true, false, false);
+                fill(Token::denominatorDigits, std::to_string(denominator), false, false, false);
+            }
+        } else {
+            RoundDecimal(value, decimals, &integer, &fraction);
+
+            // Without integer placeholders the digits go in front of the decimal point
+            if (!fill(Token::integer, integer, true, section.grouping, false)) {
+                slots.push_back(integer);
+            }
+
+            fill(Token::decimal, fraction, false, false, true);
+        }
+
+        bool integerEmitted = false;
+
+        for (size_t i = 0; i < tokens.size(); i++) {
+            const Token& token = tokens[i];
+
+            switch (token.type) {
+                case Token::literal:
+                    out->append(token.text);
+                    break;
+
+                case Token::digit:
+                    out->append(slots[i]);
+                    integerEmitted = true;
+                    break;
+
+                case Token::point:
+                    if (!integerEmitted && slots.size() > tokens.size()) out->append(slots.back());
+                    out->push_back('.');
+                    break;
+
+                case Token::exponent:
+                    out->append(token.text);
+                    if (exponentText == "-" || token.placeholder == '+') out->append(exponentText);
+                    break;
+
+                case Token::bar:
+                    out->append(barText);
+                    break;
+
+                case Token::denominator:
+                    out->append(denominatorText.empty() ? token.text : denominatorText);
+                    break;
+
+                case Token::general:
+                    AppendGeneral(out, value);
+                    break;
+
+                default:
+                    break;
+            }
+        }
+    }
+
+    void NumberFormat::RenderDate(const Section& section, libxl::Book* book, double value,
+                                  std::string* out) const {
+        // Excel has no dates before 1900 / 1904 or after 9999. The first serial past
+        // 9999-12-31 depends on the date system.
+        bool date1904 = book->isDate1904();
+        double end = date1904 ? 2957004 : 2958466;
+
+        if (value < 0 || value >= end) {
+            out->append("########");
+            return;
+        }
+
+        // Round to the precision shown
+        int64_t unitsPerSecond = 1;
+        for (int i = 0; i < section.subsecondDigits; i++) unitsPerSecond *= 10;
+
+        int64_t unitsPerDay = 86400 * unitsPerSecond;
+        int64_t total = std::llround(value * unitsPerDay);
+        int64_t days = total / unitsPerDay, units = total % unitsPerDay;
+        int64_t seconds = units / unitsPerSecond, subseconds = units % unitsPerSecond;
+
+        // Rounding may still carry into the first day after 9999-12-31
+        if (days >= end) {
+            out->append("########");
+            return;
+        }
+
+        int year = 0, month = 0, day = 0, hours, minutes, secs, milliseconds;
+        int weekday = static_cast<int>((days + (date1904 ? 5 : 6)) % 7);
+
+        book->dateUnpack(static_cast<double>(days), &year, &month, &day, &hours, &minutes, &secs,
+                         &milliseconds);
+
+        int hour = static_cast<int>(seconds / 3600), minute = static_cast<int>(seconds / 60 % 60);
+        int second = static_cast<int>(seconds % 60);
+
+        for (const Token& token : section.tokens) {
+            switch (token.type) {
+                case Token::literal:
+                    out->append(token.text);
+                    break;
+
+                case Token::year:
+                    if (token.width <= 2) {
+                        AppendPadded(out, year % 100, 2);
+                    } else {
+                        AppendPadded(out, year, 4);
+                    }
+                    break;
+
+                case Token::month:
+                    if (month < 1 || month > 12) {
+                        AppendPadded(out, month, token.width > 1 ? 2 : 1);
+                    } else if (token.width <= 2) {
+                        AppendPadded(out, month, token.width);
+                    } else if (token.width == 3) {
+                        out->append(monthNames[month - 1], 3);
+                    } else if (token.width == 4) {
+                        out->append(monthNames[month - 1]);
+                    } else {
+                        out->push_back(monthNames[month - 1][0]);
+                    }
+                    break;
+
+                case Token::day:
+                    if (token.width <= 2) {
+                        AppendPadded(out, day, token.width);
+                    } else if (token.width == 3) {
+                        out->append(dayNames[weekday], 3);
+                    } else {
+                        out->append(dayNames[weekday]);
+                    }
+                    break;
+
+                case Token::hour: {
+                    int shown = hour;
+                    if (section.twelveHours) shown = hour % 12 == 0 ? 12 : hour % 12;
+
+                    AppendPadded(out, shown, std::min(token.width, 2));
+                    break;
+                }
+
+                case Token::minute:
+                    AppendPadded(out, minute, std::min(token.width, 2));
+                    break;
+
+                case Token::second:
+                    AppendPadded(out, second, std::min(token.width, 2));
+                    break;
+
+                case Token::subsecond: {
+                    std::string digits;
+                    AppendPadded(&digits, subseconds, section.subsecondDigits);
+
+                    out->push_back('.');
+                    out->append(digits, 0, token.width);
+                    break;
+                }
+
+                case Token::ampm:
+                    out->append(hour < 12 ? token.text : token.alternate);
+                    break;
+
+                case Token::elapsedHours:
+                    AppendPadded(out, days * 24 + hour, token.width);
+                    break;
+
+                case Token::elapsedMinutes:
+                    AppendPadded(out, (days * 24 + hour) * 60 + minute, token.width);
+                    break;
+
+                case Token::elapsedSeconds:
+                    AppendPadded(out, days * 86400 + seconds, token.width);
+                    break;
+
+                default:
+                    break;
+            }
+        }
+    }
+
+    const NumberFormat& NumberFormatCache::Get(libxl::Book* book, int id) {
+        const char* custom = id >= 164 ? book->customNumFormat(id) : nullptr;
+        const char* code = custom ? custom : BuiltinCode(id);
+
+        std::unique_ptr<NumberFormat>& format = formats[id];
+        if (!format || format->Code() != code) format = std::make_unique<NumberFormat>(code);
+
+        return *format;
+    }
+
+    bool NumberFormatCache::Render(libxl::Book* book, libxl::Sheet* sheet, const CellRange& range,
+                                   std::string* data, std::vector<uint32_t>* offsets,
+                                   std::string* error) {
+        // Formats are resolved once per call, the book can not change meanwhile
+        std::unordered_map<const libxl::Format*, const NumberFormat*> resolved;
+
+        auto lookup = [&](libxl::Format* format) -> const NumberFormat& {
+            const NumberFormat*& entry = resolved[format];
+            if (!entry) entry = &Get(book, format ? format->numFormat() : 0);
+
+            return *entry;
+        };
+
+        offsets->assign(1, 0);
+
+        for (int row = range.rowFirst; row <= range.rowLast && !range.IsEmpty(); row++) {
+            for (int col = range.colFirst; col <= range.colLast; col++) {
+                libxl::CellType type = sheet->cellType(row, col);
+                libxl::Format* format = nullptr;
+
+                switch (type) {
+                    case libxl::CELLTYPE_NUMBER: {
+                        double value = sheet->readNum(row, col, &format);
+
+                        lookup(format).RenderNumber(book, value, data);
+                        break;
+                    }
+
+                    case libxl::CELLTYPE_STRING: {
+                        const char* text = sheet->readStr(row, col, &format);
+
+                        if (!text) {
+                            const char* message = book->errorMessage();
+                            *error = message;
+
+                            return false;
+                        }
+
+                        lookup(format).RenderText(text, data);
+                        break;
+                    }
+
+                    case libxl::CELLTYPE_BOOLEAN:
+                        data->append(sheet->readBool(row, col) ? "TRUE" : "FALSE");
+                        break;
+
+                    case libxl::CELLTYPE_ERROR:
+                        data->append(value_format::ErrorText(sheet->readError(row, col)));
+                        break;
+
+                    default:
+                        break;
+                }
+
+                if (data->size() > UINT32_MAX) {
+                    *error = "formatted output exceeds 4 GB";
+                    return false;
+                }
+
+                offsets->push_back(static_cast<uint32_t>(data->size()));
+            }
+        }
+
+        return true;
+    }
+
+}  // namespace node_libxl
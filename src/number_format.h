@@ -0,0 +1,96 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BINDINGS_NUMBER_FORMAT_H
+#define BINDINGS_NUMBER_FORMAT_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cell_range.h"
+#include "common.h"
+
+namespace node_libxl {
+
+    // Compiled Excel number format code (#,##0.00;[Red]-#,##0.00, yyyy-mm-dd, 0%, @, ...)
+    // that renders values the way Excel displays them, minus column width effects (fill
+    // characters are dropped and nothing is replaced by ###).
+    class NumberFormat {
+       public:
+        explicit NumberFormat(const std::string& code);
+        ~NumberFormat();
+
+        void RenderNumber(libxl::Book* book, double value, std::string* out) const;
+        void RenderText(const char* text, std::string* out) const;
+
+        const std::string& Code() const { return code; }
+
+       private:
+        struct Token;
+        struct Section;
+
+        void Compile();
+        void Parse(const std::string& text, Section* section);
+        void Finish(Section* section);
+        const Section& Pick(double value, bool* minus) const;
+
+        void RenderDigits(const Section& section, double value, std::string* out) const;
+        void RenderDate(const Section& section, libxl::Book* book, double value,
+                        std::string* out) const;
+
+        std::string code;
+        std::vector<Section> sections;
+        // Index into sections, -1 if there is no text section
+        int textSection{-1};
+    };
+
+    // Compiled number formats of a book by format id. Built-in ids map to Excel's codes,
+    // custom formats are read from the book and verified on every lookup, so a reloaded book
+    // does not render with stale codes. Not thread safe; the book must be locked by the
+    // caller.
+    class NumberFormatCache {
+       public:
+        NumberFormatCache() = default;
+
+        const NumberFormat& Get(libxl::Book* book, int id);
+
+        // Display text of the cells in range, row by row and back to back in data; cell i spans
+        // offsets[i] to offsets[i + 1]. Blank cells are empty. Does not touch V8 and may run on
+        // a worker thread. On failure false is returned and error set.
+        bool Render(libxl::Book* book, libxl::Sheet* sheet, const CellRange& range,
+                    std::string* data, std::vector<uint32_t>* offsets, std::string* error);
+
+       private:
+        NumberFormatCache(const NumberFormatCache&) = delete;
+        NumberFormatCache& operator=(const NumberFormatCache&) = delete;
+
+        std::unordered_map<int, std::unique_ptr<NumberFormat>> formats;
+    };
+
+}  // namespace node_libxl
+
+#endif  // BINDINGS_NUMBER_FORMAT_H
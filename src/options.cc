@@ -0,0 +1,87 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "options.h"
+
+using namespace v8;
+
+namespace node_libxl {
+    namespace options {
+
+        void ThrowPropertyError(const char* expected, keys::Key key) {
+            CSNanUtf8Value(name, keys::Get(key));
+            std::string message = std::string(expected) + " required for " + *name;
+
+            Nan::ThrowTypeError(message.c_str());
+        }
+
+        bool GetProperty(Local<Object> object, keys::Key key, Local<Value>* value) {
+            return Nan::Get(object, keys::Get(key)).ToLocal(value);
+        }
+
+        bool GetInt(Local<Object> object, keys::Key key, std::optional<int>* result) {
+            Local<Value> value;
+            if (!GetProperty(object, key, &value)) return false;
+            if (value->IsUndefined()) return true;
+
+            if (!value->IsInt32()) {
+                ThrowPropertyError("integer", key);
+                return false;
+            }
+
+            *result = value.As<Int32>()->Value();
+            return true;
+        }
+
+        bool GetBoolean(Local<Object> object, keys::Key key, std::optional<bool>* result) {
+            Local<Value> value;
+            if (!GetProperty(object, key, &value)) return false;
+            if (value->IsUndefined()) return true;
+
+            if (!value->IsBoolean()) {
+                ThrowPropertyError("bool", key);
+                return false;
+            }
+
+            *result = value.As<Boolean>()->Value();
+            return true;
+        }
+
+        bool GetString(Local<Object> object, keys::Key key, std::optional<std::string>* result) {
+            Local<Value> value;
+            if (!GetProperty(object, key, &value)) return false;
+            if (value->IsUndefined()) return true;
+
+            if (!value->IsString()) {
+                ThrowPropertyError("string", key);
+                return false;
+            }
+
+            CSNanUtf8Value(string, value);
+            *result = std::string(*string, string.length());
+            return true;
+        }
+
+    }  // namespace options
+}  // namespace node_libxl
@@ -0,0 +1,51 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BINDINGS_OPTIONS_H
+#define BINDINGS_OPTIONS_H
+
+#include <optional>
+#include <string>
+
+#include "common.h"
+#include "keys.h"
+
+namespace node_libxl {
+    namespace options {
+
+        // Read a property of an options / spec object. Undefined properties leave result
+        // alone. On a type mismatch a TypeError naming the property is thrown and false
+        // returned; false is also returned if a getter threw.
+        bool GetProperty(v8::Local<v8::Object> object, keys::Key key, v8::Local<v8::Value>* value);
+        bool GetInt(v8::Local<v8::Object> object, keys::Key key, std::optional<int>* result);
+        bool GetBoolean(v8::Local<v8::Object> object, keys::Key key, std::optional<bool>* result);
+        bool GetString(v8::Local<v8::Object> object, keys::Key key,
+                       std::optional<std::string>* result);
+
+        void ThrowPropertyError(const char* expected, keys::Key key);
+
+    }  // namespace options
+}  // namespace node_libxl
+
+#endif  // BINDINGS_OPTIONS_H
@@ -0,0 +1,191 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "records.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "keys.h"
+#include "options.h"
+#include "value_format.h"
+
+using namespace v8;
+
+namespace node_libxl {
+    namespace records {
+
+        namespace {
+
+            // Cell text used as record key, empty for blank cells
+            bool ReadKey(libxl::Sheet* sheet, int row, int col, std::string* key) {
+                libxl::CellType type = sheet->cellType(row, col);
+
+                switch (type) {
+                    case libxl::CELLTYPE_STRING: {
+                        const char* value = sheet->readStr(row, col);
+                        if (!value) return false;
+
+                        key->assign(value);
+                        return true;
+                    }
+
+                    case libxl::CELLTYPE_NUMBER:
+                        value_format::AppendNumber(key, sheet->readNum(row, col));
+                        return true;
+
+                    case libxl::CELLTYPE_BOOLEAN:
+                        key->assign(sheet->readBool(row, col) ? "true" : "false");
+                        return true;
+
+                    default:
+                        return true;
+                }
+            }
+
+        }  // namespace
+
+        bool ParseOptions(Local<Value> value, libxl::Sheet* sheet, Options* options) {
+            Nan::HandleScope scope;
+
+            if (value->IsUndefined()) {
+                if (!cell_range::Parse(value, sheet, &options->range)) return false;
+
+                options->headerRow = options->range.rowFirst;
+                return true;
+            }
+
+            if (!value->IsObject()) {
+                Nan::ThrowTypeError("options must be an object");
+                return false;
+            }
+
+            Local<Object> object = value.As<Object>();
+            Local<Value> range;
+            std::optional<int> headerRow;
+            std::optional<std::string> dates, blanks;
+
+            if (!options::GetProperty(object, keys::range, &range) ||
+                !cell_range::Parse(range, sheet, &options->range) ||
+                !options::GetInt(object, keys::headerRow, &headerRow) ||
+                !options::GetString(object, keys::dates, &dates) ||
+                !options::GetString(object, keys::blanks, &blanks)) {
+                return false;
+            }
+
+            if (headerRow && *headerRow < 0) {
+                Nan::ThrowTypeError("headerRow must not be negative");
+                return false;
+            }
+
+            if (dates && *dates != "iso" && *dates != "epoch") {
+                Nan::ThrowTypeError("dates must be 'iso' or 'epoch'");
+                return false;
+            }
+
+            if (blanks && *blanks != "omit" && *blanks != "null") {
+                Nan::ThrowTypeError("blanks must be 'omit' or 'null'");
+                return false;
+            }
+
+            options->headerRow = headerRow.value_or(options->range.rowFirst);
+            options->isoDates = !dates || *dates == "iso";
+            options->omitBlanks = !blanks || *blanks == "omit";
+
+            return true;
+        }
+
+        bool Build(libxl::Book* book, libxl::Sheet* sheet, const Options& options,
+                   std::string* out, std::string* error) {
+            const CellRange& range = options.range;
+            std::vector<std::string> keys;
+
+            // Pre-rendered '"key":' prefixes, empty for skipped columns
+            for (int col = range.colFirst; col <= range.colLast; col++) {
+                std::string key;
+
+                if (!ReadKey(sheet, options.headerRow, col, &key)) {
+                    const char* message = book->errorMessage();
+                    *error = message;
+
+                    return false;
+                }
+
+                keys.emplace_back();
+                if (key.empty()) continue;
+
+                value_format::AppendJsonString(&keys.back(), key.data(), key.size());
+                keys.back().push_back(':');
+            }
+
+            out->push_back('[');
+
+            int rowFirst = std::max(range.rowFirst, options.headerRow + 1);
+
+            for (int row = rowFirst; row <= range.rowLast && !range.IsEmpty(); row++) {
+                if (row > rowFirst) out->push_back(',');
+                out->push_back('{');
+
+                bool first = true;
+
+                for (int col = range.colFirst; col <= range.colLast; col++) {
+                    const std::string& key = keys[col - range.colFirst];
+                    if (key.empty()) continue;
+
+                    size_t mark = out->size();
+                    bool written;
+
+                    if (!first) out->push_back(',');
+                    out->append(key);
+
+                    if (!value_format::AppendJsonValue(out, book, sheet, row, col,
+                                                       options.isoDates, &written)) {
+                        const char* message = book->errorMessage();
+                        *error = message;
+
+                        return false;
+                    }
+
+                    if (!written) {
+                        if (options.omitBlanks) {
+                            out->resize(mark);
+                            continue;
+                        }
+
+                        out->append("null");
+                    }
+
+                    first = false;
+                }
+
+                out->push_back('}');
+            }
+
+            out->push_back(']');
+
+            return true;
+        }
+
+    }  // namespace records
+}  // namespace node_libxl
@@ -0,0 +1,59 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BINDINGS_RECORDS_H
+#define BINDINGS_RECORDS_H
+
+#include <string>
+
+#include "cell_range.h"
+#include "common.h"
+
+namespace node_libxl {
+    namespace records {
+
+        struct Options {
+            CellRange range;
+            int headerRow{0};
+            // Dates as ISO 8601 strings instead of milliseconds since the epoch
+            bool isoDates{true};
+            // Skip blank cells instead of writing null
+            bool omitBlanks{true};
+        };
+
+        // Read {headerRow, range, dates: 'iso' | 'epoch', blanks: 'omit' | 'null'}. The header
+        // row defaults to the first row of the range. Throws a TypeError and returns false if
+        // the options are malformed.
+        bool ParseOptions(v8::Local<v8::Value> value, libxl::Sheet* sheet, Options* options);
+
+        // Render the rows below the header as a JSON array of objects keyed by the header
+        // cells. Columns with a blank header are skipped. Does not touch V8 and may run on a
+        // worker thread. On failure false is returned and error set.
+        bool Build(libxl::Book* book, libxl::Sheet* sheet, const Options& options,
+                   std::string* out, std::string* error);
+
+    }  // namespace records
+}  // namespace node_libxl
+
+#endif  // BINDINGS_RECORDS_H
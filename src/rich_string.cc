@@ -27,6 +27,7 @@
 #include "argument_helper.h"
 #include "assert.h"
 #include "font.h"
+#include "keys.h"
 #include "util.h"
 
 using namespace v8;
@@ -111,11 +112,9 @@ namespace node_libxl {
         }
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("text").ToLocalChecked(),
-                 Nan::New<String>(text).ToLocalChecked());
+        Nan::Set(result, keys::Get(keys::text), Nan::New<String>(text).ToLocalChecked());
         if (font) {
-            Nan::Set(result, Nan::New<String>("font").ToLocalChecked(),
-                     Font::NewInstance(font, that->GetBookHandle()));
+            Nan::Set(result, keys::Get(keys::font), Font::NewInstance(font, that->GetBookHandle()));
         }
 
         info.GetReturnValue().Set(result);
@@ -153,6 +152,7 @@ namespace node_libxl {
 
         t->ReadOnlyPrototype();
         constructor.Reset(Nan::GetFunction(t).ToLocalChecked());
+        functionTemplate.Reset(t);
         Nan::Set(exports, Nan::New<String>("RichString").ToLocalChecked(), Nan::New(constructor));
     }
 }  // namespace node_libxl
@@ -24,13 +24,28 @@
 
 #include "sheet.h"
 
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+#include "args.h"
 #include "argument_helper.h"
+#include "arrow_ipc.h"
 #include "assert.h"
 #include "async_worker.h"
 #include "auto_filter.h"
+#include "buffer_copy.h"
+#include "cell_address.h"
+#include "cell_range.h"
+#include "column_batch.h"
 #include "conditional_formatting.h"
+#include "csv.h"
 #include "form_control.h"
 #include "format.h"
+#include "keys.h"
+#include "number_format.h"
+#include "records.h"
 #include "rich_string.h"
 #include "table.h"
 #include "util.h"
@@ -52,11 +67,16 @@ namespace node_libxl {
     Local<Object> Sheet::NewInstance(libxl::Sheet* libxlSheet, Local<Value> book) {
         Nan::EscapableHandleScope scope;
 
+        Local<Object> that =
+            Book::FromJS(book)->LookupWrapper(Book::WrapperKind::sheet, libxlSheet);
+        if (!that.IsEmpty()) return scope.Escape(that);
+
         Sheet* sheet = new Sheet(libxlSheet, book);
 
-        Local<Object> that = util::CallStubConstructor(Nan::New(constructor)).As<Object>();
+        that = util::CallStubConstructor(Nan::New(constructor)).As<Object>();
 
         sheet->Wrap(that);
+        sheet->RegisterIdentity(Book::WrapperKind::sheet, libxlSheet, sheet);
 
         return scope.Escape(that);
     }
@@ -66,11 +86,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::CellType) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0);
-        int col = arguments.GetInt(1);
+        Args<int, int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row, col] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -86,11 +104,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::IsFormula) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0);
-        int col = arguments.GetInt(1);
+        Args<int, int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row, col] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -101,11 +117,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::CellFormat) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0);
-        int col = arguments.GetInt(1);
+        Args<int, int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row, col] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -121,12 +135,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::SetCellFormat) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0);
-        int col = arguments.GetInt(1);
-        Format* format = arguments.GetWrapped<Format>(2);
+        Args<int, int, Format> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row, col, format] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -156,11 +167,11 @@ namespace node_libxl {
         }
 
         if (formatRef->IsObject() && libxlFormat) {
-            Nan::Set(formatRef.As<Object>(), Nan::New<String>("format").ToLocalChecked(),
+            Nan::Set(formatRef.As<Object>(), keys::Get(keys::format),
                      Format::NewInstance(libxlFormat, that->GetBookHandle()));
         }
 
-        info.GetReturnValue().Set(Nan::New<String>(value).ToLocalChecked());
+        info.GetReturnValue().Set(that->GetBook()->GetStringCache().Get(value));
     }
 
     NAN_METHOD(Sheet::WriteStr) {
@@ -187,6 +198,34 @@ namespace node_libxl {
         info.GetReturnValue().Set(info.This());
     }
 
+    NAN_METHOD(Sheet::WriteInterned) {
+        Nan::HandleScope scope;
+
+        ArgumentHelper arguments(info);
+
+        int row = arguments.GetInt(0);
+        int col = arguments.GetInt(1);
+        double handle = arguments.GetDouble(2);
+        Format* format = arguments.GetWrapped<Format>(3, NULL);
+        ASSERT_ARGUMENTS(arguments);
+
+        Sheet* that = FromJS(info.This());
+        ASSERT_SHEET(that);
+        if (format) {
+            ASSERT_SAME_BOOK(that, format);
+        }
+
+        // Interned strings are already encoded
+        const char* value = that->GetBook()->GetInternedString(handle);
+        if (!value) return Nan::ThrowTypeError("invalid string handle");
+
+        if (!that->GetWrapped()->writeStr(row, col, value, format ? format->GetWrapped() : NULL)) {
+            return util::ThrowLibxlError(that);
+        }
+
+        info.GetReturnValue().Set(info.This());
+    }
+
     NAN_METHOD(Sheet::ReadRichStr) {
         Nan::HandleScope scope;
 
@@ -207,7 +246,7 @@ namespace node_libxl {
         }
 
         if (formatRef->IsObject() && libxlFormat) {
-            Nan::Set(formatRef.As<Object>(), Nan::New<String>("format").ToLocalChecked(),
+            Nan::Set(formatRef.As<Object>(), keys::Get(keys::format),
                      Format::NewInstance(libxlFormat, that->GetBookHandle()));
         }
 
@@ -217,14 +256,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::WriteRichStr) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0);
-        int col = arguments.GetInt(1);
-        RichString* richString = arguments.GetWrapped<RichString>(2);
-        Format* format = arguments.GetWrapped<Format>(3, nullptr);
-
+        Args<int, int, RichString, Optional<Format>> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row, col, richString, format] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -256,7 +290,7 @@ namespace node_libxl {
         double value = that->GetWrapped()->readNum(row, col, &libxlFormat);
 
         if (formatRef->IsObject() && libxlFormat) {
-            Nan::Set(formatRef.As<Object>(), Nan::New<String>("format").ToLocalChecked(),
+            Nan::Set(formatRef.As<Object>(), keys::Get(keys::format),
                      Format::NewInstance(libxlFormat, that->GetBookHandle()));
         }
 
@@ -266,13 +300,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::WriteNum) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0);
-        int col = arguments.GetInt(1);
-        double value = arguments.GetDouble(2);
-        Format* format = arguments.GetWrapped<Format>(3, NULL);
+        Args<int, int, double, Optional<Format>> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row, col, value, format] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -303,7 +333,7 @@ namespace node_libxl {
         bool value = that->GetWrapped()->readBool(row, col, &libxlFormat);
 
         if (formatRef->IsObject() && libxlFormat) {
-            Nan::Set(formatRef.As<Object>(), Nan::New<String>("format").ToLocalChecked(),
+            Nan::Set(formatRef.As<Object>(), keys::Get(keys::format),
                      Format::NewInstance(libxlFormat, that->GetBookHandle()));
         }
 
@@ -313,13 +343,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::WriteBool) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0);
-        int col = arguments.GetInt(1);
-        bool value = arguments.GetBoolean(2);
-        Format* format = arguments.GetWrapped<Format>(3, NULL);
+        Args<int, int, bool, Optional<Format>> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row, col, value, format] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -354,8 +380,7 @@ namespace node_libxl {
         Local<Value> formatHandle = Format::NewInstance(libxlFormat, that->GetBookHandle());
 
         if (formatRef->IsObject() && libxlFormat) {
-            Nan::Set(formatRef.As<Object>(), Nan::New<String>("format").ToLocalChecked(),
-                     formatHandle);
+            Nan::Set(formatRef.As<Object>(), keys::Get(keys::format), formatHandle);
         }
 
         info.GetReturnValue().Set(formatHandle);
@@ -364,12 +389,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::WriteBlank) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0);
-        int col = arguments.GetInt(1);
-        Format* format = arguments.GetWrapped<Format>(2);
+        Args<int, int, Format> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row, col, format] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -401,7 +423,7 @@ namespace node_libxl {
         }
 
         if (formatRef->IsObject() && libxlFormat) {
-            Nan::Set(formatRef.As<Object>(), Nan::New<String>("format").ToLocalChecked(),
+            Nan::Set(formatRef.As<Object>(), keys::Get(keys::format),
                      Format::NewInstance(libxlFormat, that->GetBookHandle()));
         }
 
@@ -514,10 +536,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::ReadComment) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-        int row = arguments.GetInt(0);
-        int col = arguments.GetInt(1);
+        Args<int, int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row, col] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -558,10 +579,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::RemoveComment) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-        int row = arguments.GetInt(0);
-        int col = arguments.GetInt(1);
+        Args<int, int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row, col] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -574,11 +594,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::ReadError) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0);
-        int col = arguments.GetInt(1);
+        Args<int, int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row, col] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -589,13 +607,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::WriteError) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0);
-        int col = arguments.GetInt(1);
-        int error = arguments.GetInt(2);
-        Format* format = arguments.GetWrapped<Format>(3, nullptr);
+        Args<int, int, int, Optional<Format>> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row, col, error, format] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -612,10 +626,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::IsDate) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0), col = arguments.GetInt(1);
+        Args<int, int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row, col] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -623,13 +636,77 @@ namespace node_libxl {
         info.GetReturnValue().Set(Nan::New<Boolean>(that->GetWrapped()->isDate(row, col)));
     }
 
-    NAN_METHOD(Sheet::IsRichStr) {
+    NAN_METHOD(Sheet::ReadCell) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
+        Args<int, int> arguments(info);
+        ASSERT_ARGUMENTS(arguments);
+        auto [row, col] = arguments.Get();
 
-        int row = arguments.GetInt(0), col = arguments.GetInt(1);
+        Sheet* that = FromJS(info.This());
+        ASSERT_SHEET(that);
+
+        libxl::Sheet* sheet = that->GetWrapped();
+        libxl::Format* libxlFormat = NULL;
+        libxl::CellType cellType = sheet->cellType(row, col);
+        bool isDate = false;
+        Local<Value> value = Nan::Null();
+
+        switch (cellType) {
+            case libxl::CELLTYPE_NUMBER:
+                value = Nan::New<Number>(sheet->readNum(row, col, &libxlFormat));
+                isDate = sheet->isDate(row, col);
+                break;
+
+            case libxl::CELLTYPE_STRING: {
+                const char* string = sheet->readStr(row, col, &libxlFormat);
+                if (!string) {
+                    return util::ThrowLibxlError(that);
+                }
+
+                value = that->GetBook()->GetStringCache().Get(string);
+                break;
+            }
+
+            case libxl::CELLTYPE_BOOLEAN:
+                value = Nan::New<Boolean>(sheet->readBool(row, col, &libxlFormat));
+                break;
+
+            case libxl::CELLTYPE_ERROR:
+                value = Nan::New<Integer>(sheet->readError(row, col));
+                libxlFormat = sheet->cellFormat(row, col);
+                break;
+
+            case libxl::CELLTYPE_BLANK:
+                sheet->readBlank(row, col, &libxlFormat);
+                break;
+
+            default:
+                break;
+        }
+
+        Book* book = that->GetBook();
+        int formatIndex = book->GetStyleRegistry().FormatIndex(book->GetWrapped(), libxlFormat);
+
+        // Reusing the caller's object saves an allocation per cell, and setting the
+        // properties in a fixed order keeps its shape stable
+        Local<Object> result = info[2]->IsObject() ? info[2].As<Object>() : Nan::New<Object>();
+
+        Nan::Set(result, keys::Get(keys::type), Nan::New<Integer>(cellType));
+        Nan::Set(result, keys::Get(keys::value), value);
+        Nan::Set(result, keys::Get(keys::formula), Nan::New<Boolean>(sheet->isFormula(row, col)));
+        Nan::Set(result, keys::Get(keys::date), Nan::New<Boolean>(isDate));
+        Nan::Set(result, keys::Get(keys::format), Nan::New<Integer>(formatIndex));
+
+        info.GetReturnValue().Set(result);
+    }
+
+    NAN_METHOD(Sheet::IsRichStr) {
+        Nan::HandleScope scope;
+
+        Args<int, int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row, col] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -640,10 +717,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::ColWidth) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int col = arguments.GetInt(0);
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [col] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -654,10 +730,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::RowHeight) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0);
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -668,10 +743,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::ColWidthPx) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int col = arguments.GetInt(0);
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [col] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -682,10 +756,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::RowHeightPx) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0);
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -798,10 +871,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::ColFormat) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int col = arguments.GetInt(0);
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [col] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -817,10 +889,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::RowFormat) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0);
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -836,10 +907,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::RowHidden) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0);
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -850,11 +920,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::SetRowHidden) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0);
-        bool hidden = arguments.GetBoolean(1);
+        Args<int, bool> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row, hidden] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -869,10 +937,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::ColHidden) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int col = arguments.GetInt(0);
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [col] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -883,11 +950,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::SetColHidden) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int col = arguments.GetInt(0);
-        bool hidden = arguments.GetBoolean(1);
+        Args<int, bool> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [col, hidden] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -914,9 +979,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::SetDefaultRowHeight) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-        double height = arguments.GetDouble(0);
+        Args<double> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [height] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -929,10 +994,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::GetMerge) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0), col = arguments.GetInt(1);
+        Args<int, int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row, col] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -944,12 +1008,10 @@ namespace node_libxl {
         }
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("rowFirst").ToLocalChecked(),
-                 Nan::New<Integer>(rowFirst));
-        Nan::Set(result, Nan::New<String>("rowLast").ToLocalChecked(), Nan::New<Integer>(rowLast));
-        Nan::Set(result, Nan::New<String>("colFirst").ToLocalChecked(),
-                 Nan::New<Integer>(colFirst));
-        Nan::Set(result, Nan::New<String>("colLast").ToLocalChecked(), Nan::New<Integer>(colLast));
+        Nan::Set(result, keys::Get(keys::rowFirst), Nan::New<Integer>(rowFirst));
+        Nan::Set(result, keys::Get(keys::rowLast), Nan::New<Integer>(rowLast));
+        Nan::Set(result, keys::Get(keys::colFirst), Nan::New<Integer>(colFirst));
+        Nan::Set(result, keys::Get(keys::colLast), Nan::New<Integer>(colLast));
 
         info.GetReturnValue().Set(result);
     }
@@ -957,13 +1019,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::SetMerge) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int rowFirst = arguments.GetInt(0);
-        int rowLast = arguments.GetInt(1);
-        int colFirst = arguments.GetInt(2);
-        int colLast = arguments.GetInt(3);
+        Args<int, int, int, int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [rowFirst, rowLast, colFirst, colLast] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -978,10 +1036,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::DelMerge) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0), col = arguments.GetInt(1);
+        Args<int, int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row, col] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -1008,10 +1065,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::Merge) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int index = arguments.GetInt(0);
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [index] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -1023,12 +1079,10 @@ namespace node_libxl {
         }
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("rowFirst").ToLocalChecked(),
-                 Nan::New<Integer>(rowFirst));
-        Nan::Set(result, Nan::New<String>("rowLast").ToLocalChecked(), Nan::New<Integer>(rowLast));
-        Nan::Set(result, Nan::New<String>("colFirst").ToLocalChecked(),
-                 Nan::New<Integer>(colFirst));
-        Nan::Set(result, Nan::New<String>("colLast").ToLocalChecked(), Nan::New<Integer>(colLast));
+        Nan::Set(result, keys::Get(keys::rowFirst), Nan::New<Integer>(rowFirst));
+        Nan::Set(result, keys::Get(keys::rowLast), Nan::New<Integer>(rowLast));
+        Nan::Set(result, keys::Get(keys::colFirst), Nan::New<Integer>(colFirst));
+        Nan::Set(result, keys::Get(keys::colLast), Nan::New<Integer>(colLast));
 
         info.GetReturnValue().Set(result);
     }
@@ -1036,10 +1090,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::DelMergeByIndex) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int index = arguments.GetInt(0);
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [index] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -1063,10 +1116,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::GetPicture) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int sheetIndex = arguments.GetInt(0);
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [sheetIndex] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -1082,22 +1134,17 @@ namespace node_libxl {
         }
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("bookIndex").ToLocalChecked(),
-                 Nan::New<Integer>(bookIndex));
-        Nan::Set(result, Nan::New<String>("rowTop").ToLocalChecked(), Nan::New<Integer>(rowTop));
-        Nan::Set(result, Nan::New<String>("colLeft").ToLocalChecked(), Nan::New<Integer>(colLeft));
-        Nan::Set(result, Nan::New<String>("rowBottom").ToLocalChecked(),
-                 Nan::New<Integer>(rowBottom));
-        Nan::Set(result, Nan::New<String>("colRight").ToLocalChecked(),
-                 Nan::New<Integer>(colRight));
-        Nan::Set(result, Nan::New<String>("width").ToLocalChecked(), Nan::New<Integer>(width));
-        Nan::Set(result, Nan::New<String>("height").ToLocalChecked(), Nan::New<Integer>(height));
-        Nan::Set(result, Nan::New<String>("offset_x").ToLocalChecked(),
-                 Nan::New<Integer>(offset_x));
-        Nan::Set(result, Nan::New<String>("offset_y").ToLocalChecked(),
-                 Nan::New<Integer>(offset_y));
+        Nan::Set(result, keys::Get(keys::bookIndex), Nan::New<Integer>(bookIndex));
+        Nan::Set(result, keys::Get(keys::rowTop), Nan::New<Integer>(rowTop));
+        Nan::Set(result, keys::Get(keys::colLeft), Nan::New<Integer>(colLeft));
+        Nan::Set(result, keys::Get(keys::rowBottom), Nan::New<Integer>(rowBottom));
+        Nan::Set(result, keys::Get(keys::colRight), Nan::New<Integer>(colRight));
+        Nan::Set(result, keys::Get(keys::width), Nan::New<Integer>(width));
+        Nan::Set(result, keys::Get(keys::height), Nan::New<Integer>(height));
+        Nan::Set(result, keys::Get(keys::offset_x), Nan::New<Integer>(offset_x));
+        Nan::Set(result, keys::Get(keys::offset_y), Nan::New<Integer>(offset_y));
         if (linkPath) {
-            Nan::Set(result, Nan::New<String>("linkPath").ToLocalChecked(),
+            Nan::Set(result, keys::Get(keys::linkPath),
                      Nan::New<String>(linkPath).ToLocalChecked());
         }
 
@@ -1107,10 +1154,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::RemovePicture) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0), col = arguments.GetInt(1);
+        Args<int, int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row, col] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -1125,10 +1171,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::RemovePictureByIndex) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int index = arguments.GetInt(0);
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [index] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -1182,10 +1227,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::GetHorPageBreak) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int index = arguments.GetInt(0);
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [index] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -1208,10 +1252,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::GetVerPageBreak) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int index = arguments.GetInt(0);
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [index] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -1272,10 +1315,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::Split) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0), col = arguments.GetInt(1);
+        Args<int, int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row, col] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -1301,8 +1343,8 @@ namespace node_libxl {
         }
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("row").ToLocalChecked(), Nan::New<Integer>(row));
-        Nan::Set(result, Nan::New<String>("col").ToLocalChecked(), Nan::New<Integer>(col));
+        Nan::Set(result, keys::Get(keys::row), Nan::New<Integer>(row));
+        Nan::Set(result, keys::Get(keys::col), Nan::New<Integer>(col));
 
         info.GetReturnValue().Set(result);
     }
@@ -1360,10 +1402,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::SetGroupSummaryBelow) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        bool summaryBelow = arguments.GetBoolean(0);
+        Args<bool> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [summaryBelow] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -1388,10 +1429,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::SetGroupSummaryRight) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        bool summaryRight = arguments.GetBoolean(0);
+        Args<bool> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [summaryRight] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -1547,133 +1587,579 @@ namespace node_libxl {
 
         ArgumentHelper arguments(info);
 
-        int rowFirst = arguments.GetInt(0), rowLast = arguments.GetInt(1);
-        bool updateNamedRanges = arguments.GetBoolean(2, true);
+        int rowFirst = arguments.GetInt(0), rowLast = arguments.GetInt(1);
+        bool updateNamedRanges = arguments.GetBoolean(2, true);
+        ASSERT_ARGUMENTS(arguments);
+
+        Sheet* that = FromJS(info.This());
+        ASSERT_SHEET(that);
+
+        if (!that->GetWrapped()->removeRow(rowFirst, rowLast, updateNamedRanges)) {
+            return util::ThrowLibxlError(that);
+        }
+
+        info.GetReturnValue().Set(info.This());
+    }
+
+    NAN_METHOD(Sheet::RemoveRowAsync) {
+        class Worker : public AsyncWorker<Sheet> {
+           public:
+            Worker(Nan::Callback* callback, Local<Object> that, int rowFirst, int rowLast,
+                   bool updateNamedRanges)
+                : AsyncWorker<Sheet>(callback, that, "node-livxl-remove-row"),
+                  rowFirst(rowFirst),
+                  rowLast(rowLast),
+                  updateNamedRanges(updateNamedRanges) {}
+
+            virtual void Execute() {
+                if (!that->GetWrapped()->removeRow(rowFirst, rowLast, updateNamedRanges)) {
+                    RaiseLibxlError();
+                }
+            }
+
+           private:
+            int rowFirst, rowLast;
+            bool updateNamedRanges;
+        };
+
+        Nan::HandleScope scope;
+
+        ArgumentHelper arguments(info);
+
+        if (arguments.Length() > 4) {
+            return Nan::ThrowError("too many arguments");
+        }
+
+        int rowFirst = arguments.GetInt(0), rowLast = arguments.GetInt(1);
+        bool updateNamedRanges = arguments.Length() > 3 ? arguments.GetBoolean(2, true) : true;
+        Local<Function> callback = arguments.GetFunction(arguments.Length() - 1);
+        ASSERT_ARGUMENTS(arguments);
+
+        Sheet* that = FromJS(info.This());
+        ASSERT_SHEET(that);
+
+        Nan::AsyncQueueWorker(new Worker(new Nan::Callback(callback), info.This(), rowFirst,
+                                         rowLast, updateNamedRanges));
+
+        info.GetReturnValue().Set(info.This());
+    }
+
+    NAN_METHOD(Sheet::RemoveColAsync) {
+        class Worker : public AsyncWorker<Sheet> {
+           public:
+            Worker(Nan::Callback* callback, Local<Object> that, int colFirst, int colLast,
+                   bool removeNamedRanges)
+                : AsyncWorker<Sheet>(callback, that, "node-libxl-remove-col"),
+                  colFirst(colFirst),
+                  colLast(colLast),
+                  removeNamedRanges(removeNamedRanges) {}
+
+            virtual void Execute() {
+                if (!that->GetWrapped()->removeCol(colFirst, colLast, removeNamedRanges)) {
+                    RaiseLibxlError();
+                }
+            }
+
+           private:
+            int colFirst, colLast;
+            bool removeNamedRanges;
+        };
+
+        Nan::HandleScope scope;
+
+        ArgumentHelper arguments(info);
+
+        if (arguments.Length() > 4) {
+            return Nan::ThrowError("too many arguments");
+        }
+
+        int colFirst = arguments.GetInt(0), colLast = arguments.GetInt(1);
+        bool updateNamedRanges = arguments.Length() > 3 ? arguments.GetBoolean(2, true) : true;
+        Local<Function> callback = arguments.GetFunction(arguments.Length() - 1);
+        ASSERT_ARGUMENTS(arguments);
+
+        Sheet* that = FromJS(info.This());
+        ASSERT_SHEET(that);
+
+        Nan::AsyncQueueWorker(new Worker(new Nan::Callback(callback), info.This(), colFirst,
+                                         colLast, updateNamedRanges));
+
+        info.GetReturnValue().Set(info.This());
+    }
+
+    NAN_METHOD(Sheet::RemoveCol) {
+        Nan::HandleScope scope;
+
+        ArgumentHelper arguments(info);
+
+        int colFirst = arguments.GetInt(0), colLast = arguments.GetInt(1);
+        bool updateNamedRanges = arguments.GetBoolean(2, true);
+        ASSERT_ARGUMENTS(arguments);
+
+        Sheet* that = FromJS(info.This());
+        ASSERT_SHEET(that);
+
+        if (!that->GetWrapped()->removeCol(colFirst, colLast, updateNamedRanges)) {
+            return util::ThrowLibxlError(that);
+        }
+
+        info.GetReturnValue().Set(info.This());
+    }
+
+    NAN_METHOD(Sheet::WriteColumnsAsync) {
+        class Worker : public AsyncWorker<Sheet> {
+           public:
+            Worker(Nan::Callback* callback, Local<Object> that, int row, int col,
+                   std::unique_ptr<ColumnBatch> batch)
+                : AsyncWorker<Sheet>(callback, that, "node-libxl-sheet-write-columns"),
+                  row(row),
+                  col(col),
+                  batch(std::move(batch)) {}
+
+            virtual void Execute() {
+                Book* book = that->GetBook();
+                std::string error;
+
+                if (!batch->Write(book->GetWrapped(), &book->GetStyleRegistry(),
+                                  that->GetWrapped(), row, col, &error)) {
+                    SetErrorMessage(error.c_str());
+                }
+            }
+
+            virtual void HandleOKCallback() {
+                Nan::HandleScope scope;
+
+                Local<Value> argv[] = {Nan::Undefined(), Nan::New<Integer>(batch->Rows())};
+
+                callback->Call(2, argv, async_resource);
+            }
+
+           private:
+            int row, col;
+            std::unique_ptr<ColumnBatch> batch;
+        };
+
+        Nan::HandleScope scope;
+
+        ArgumentHelper arguments(info);
+
+        if (arguments.Length() > 5) {
+            return Nan::ThrowError("too many arguments");
+        }
+
+        int row = arguments.GetInt(0), col = arguments.GetInt(1);
+        Local<Function> callback = arguments.GetFunction(arguments.Length() - 1);
+        ASSERT_ARGUMENTS(arguments);
+
+        Local<Value> formats = arguments.Length() > 4 ? info[3] : Nan::Undefined().As<Value>();
+
+        if (row < 0 || col < 0) {
+            return Nan::ThrowTypeError("row and col must not be negative");
+        }
+
+        Sheet* that = FromJS(info.This());
+        ASSERT_SHEET(that);
+
+        auto batch = std::make_unique<ColumnBatch>();
+        if (!batch->Parse(info[2], formats, that->GetBook())) return;
+
+        Nan::AsyncQueueWorker(
+            new Worker(new Nan::Callback(callback), info.This(), row, col, std::move(batch)));
+
+        info.GetReturnValue().Set(info.This());
+    }
+
+    NAN_METHOD(Sheet::ExportCsvAsync) {
+        class Worker : public AsyncWorker<Sheet> {
+           public:
+            Worker(Nan::Callback* callback, Local<Object> that, int fd,
+                   const csv::ExportOptions& options)
+                : AsyncWorker<Sheet>(callback, that, "node-libxl-sheet-export-csv"),
+                  fd(fd),
+                  options(options) {}
+
+            virtual void Execute() {
+                std::string out, error;
+
+                if (!csv::Export(util::UnwrapBook(that), that->GetWrapped(), options, fd, &out,
+                                 &written, &error)) {
+                    return SetErrorMessage(error.c_str());
+                }
+
+                if (fd >= 0) return;
+
+                if (!util::FitsBuffer(out.size())) {
+                    return SetErrorMessage("CSV output exceeds the maximum buffer size");
+                }
+
+                buffer = new char[out.size()];
+                memcpy(buffer, out.data(), out.size());
+            }
+
+            virtual void HandleOKCallback() {
+                Nan::HandleScope scope;
+
+                Local<Value> result =
+                    fd >= 0 ? Nan::New<Number>(static_cast<double>(written)).As<Value>()
+                            : Nan::NewBuffer(buffer, static_cast<uint32_t>(written))
+                                  .ToLocalChecked()
+                                  .As<Value>();
+
+                Local<Value> argv[] = {Nan::Undefined(), result};
+
+                callback->Call(2, argv, async_resource);
+            }
+
+           private:
+            int fd;
+            csv::ExportOptions options;
+            char* buffer{nullptr};
+            uint64_t written{0};
+        };
+
+        Nan::HandleScope scope;
+
+        ArgumentHelper arguments(info);
+
+        if (arguments.Length() > 3) {
+            return Nan::ThrowError("too many arguments");
+        }
+
+        Local<Function> callback = arguments.GetFunction(arguments.Length() - 1);
+        ASSERT_ARGUMENTS(arguments);
+
+        Local<Value> target = info[0];
+        Local<Value> options = arguments.Length() > 2 ? info[1] : Nan::Undefined().As<Value>();
+
+        int fd = -1;
+
+        if (target->IsInt32() && Nan::To<int32_t>(target).FromJust() >= 0) {
+            fd = Nan::To<int32_t>(target).FromJust();
+        } else if (!target->IsNullOrUndefined()) {
+            return Nan::ThrowTypeError("target must be a file descriptor, null or undefined");
+        }
+
+        Sheet* that = FromJS(info.This());
+        ASSERT_SHEET(that);
+
+        csv::ExportOptions exportOptions;
+        if (!csv::ParseExportOptions(options, that->GetWrapped(), &exportOptions)) return;
+
+        Nan::AsyncQueueWorker(
+            new Worker(new Nan::Callback(callback), info.This(), fd, exportOptions));
+
+        info.GetReturnValue().Set(info.This());
+    }
+
+    NAN_METHOD(Sheet::ImportCsvAsync) {
+        class Worker : public AsyncWorker<Sheet> {
+           public:
+            Worker(Nan::Callback* callback, Local<Object> that, Local<Value> source,
+                   const csv::ImportOptions& options)
+                : AsyncWorker<Sheet>(callback, that, "node-libxl-sheet-import-csv"),
+                  options(options) {
+                if (node::Buffer::HasInstance(source)) {
+                    buffer = std::make_unique<BufferCopy>(source);
+                } else {
+                    path = *Nan::Utf8String(source);
+                }
+            }
+
+            virtual void Execute() {
+                std::string contents, error;
+
+                if (!buffer && !ReadFile(&contents)) return;
+
+                const char* data = buffer ? **buffer : contents.data();
+                size_t size = buffer ? buffer->GetSize() : contents.size();
+                Book* book = that->GetBook();
+
+                if (!csv::Import(book->GetWrapped(), &book->GetStyleRegistry(), that->GetWrapped(),
+                                 options, data, size, &rows, &error)) {
+                    SetErrorMessage(error.c_str());
+                }
+            }
+
+            virtual void HandleOKCallback() {
+                Nan::HandleScope scope;
+
+                Local<Value> argv[] = {Nan::Undefined(), Nan::New<Integer>(rows)};
+
+                callback->Call(2, argv, async_resource);
+            }
+
+           private:
+            bool ReadFile(std::string* contents) {
+                FILE* file = fopen(path.c_str(), "rb");
+
+                if (!file) {
+                    SetErrorMessage(strerror(errno));
+                    return false;
+                }
+
+                char chunk[1 << 16];
+                size_t count;
+
+                while ((count = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+                    contents->append(chunk, count);
+                }
+
+                bool failed = ferror(file);
+                fclose(file);
+
+                if (failed) SetErrorMessage("failed to read CSV file");
+
+                return !failed;
+            }
+
+            std::unique_ptr<BufferCopy> buffer;
+            std::string path;
+            csv::ImportOptions options;
+            int rows{0};
+        };
+
+        Nan::HandleScope scope;
+
+        ArgumentHelper arguments(info);
+
+        if (arguments.Length() > 3) {
+            return Nan::ThrowError("too many arguments");
+        }
+
+        Local<Function> callback = arguments.GetFunction(arguments.Length() - 1);
         ASSERT_ARGUMENTS(arguments);
 
+        Local<Value> source = info[0];
+        Local<Value> options = arguments.Length() > 2 ? info[1] : Nan::Undefined().As<Value>();
+
+        if (!node::Buffer::HasInstance(source) && !source->IsString()) {
+            return Nan::ThrowTypeError("source must be a buffer or a file name");
+        }
+
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
 
-        if (!that->GetWrapped()->removeRow(rowFirst, rowLast, updateNamedRanges)) {
-            return util::ThrowLibxlError(that);
-        }
+        csv::ImportOptions importOptions;
+        if (!csv::ParseImportOptions(options, that->GetBook(), &importOptions)) return;
+
+        Nan::AsyncQueueWorker(
+            new Worker(new Nan::Callback(callback), info.This(), source, importOptions));
 
         info.GetReturnValue().Set(info.This());
     }
 
-    NAN_METHOD(Sheet::RemoveRowAsync) {
+    NAN_METHOD(Sheet::ToRecordsAsync) {
         class Worker : public AsyncWorker<Sheet> {
            public:
-            Worker(Nan::Callback* callback, Local<Object> that, int rowFirst, int rowLast,
-                   bool updateNamedRanges)
-                : AsyncWorker<Sheet>(callback, that, "node-livxl-remove-row"),
-                  rowFirst(rowFirst),
-                  rowLast(rowLast),
-                  updateNamedRanges(updateNamedRanges) {}
+            Worker(Nan::Callback* callback, Local<Object> that, const records::Options& options)
+                : AsyncWorker<Sheet>(callback, that, "node-libxl-sheet-to-records"),
+                  options(options) {}
 
             virtual void Execute() {
-                if (!that->GetWrapped()->removeRow(rowFirst, rowLast, updateNamedRanges)) {
-                    RaiseLibxlError();
+                std::string out, error;
+
+                if (!records::Build(util::UnwrapBook(that), that->GetWrapped(), options, &out,
+                                    &error)) {
+                    return SetErrorMessage(error.c_str());
                 }
+
+                if (!util::FitsBuffer(out.size())) {
+                    return SetErrorMessage("JSON output exceeds the maximum buffer size");
+                }
+
+                size = out.size();
+                buffer = new char[size];
+                memcpy(buffer, out.data(), size);
+            }
+
+            virtual void HandleOKCallback() {
+                Nan::HandleScope scope;
+
+                Local<Value> argv[] = {
+                    Nan::Undefined(),
+                    Nan::NewBuffer(buffer, static_cast<uint32_t>(size)).ToLocalChecked()};
+
+                callback->Call(2, argv, async_resource);
             }
 
            private:
-            int rowFirst, rowLast;
-            bool updateNamedRanges;
+            records::Options options;
+            char* buffer{nullptr};
+            size_t size{0};
         };
 
         Nan::HandleScope scope;
 
         ArgumentHelper arguments(info);
 
-        if (arguments.Length() > 4) {
+        if (arguments.Length() > 2) {
             return Nan::ThrowError("too many arguments");
         }
 
-        int rowFirst = arguments.GetInt(0), rowLast = arguments.GetInt(1);
-        bool updateNamedRanges = arguments.Length() > 3 ? arguments.GetBoolean(2, true) : true;
         Local<Function> callback = arguments.GetFunction(arguments.Length() - 1);
         ASSERT_ARGUMENTS(arguments);
 
+        Local<Value> options = arguments.Length() > 1 ? info[0] : Nan::Undefined().As<Value>();
+
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
 
-        Nan::AsyncQueueWorker(new Worker(new Nan::Callback(callback), info.This(), rowFirst,
-                                         rowLast, updateNamedRanges));
+        records::Options recordsOptions;
+        if (!records::ParseOptions(options, that->GetWrapped(), &recordsOptions)) return;
+
+        Nan::AsyncQueueWorker(new Worker(new Nan::Callback(callback), info.This(), recordsOptions));
 
         info.GetReturnValue().Set(info.This());
     }
 
-    NAN_METHOD(Sheet::RemoveColAsync) {
+    NAN_METHOD(Sheet::ToArrowAsync) {
         class Worker : public AsyncWorker<Sheet> {
            public:
-            Worker(Nan::Callback* callback, Local<Object> that, int colFirst, int colLast,
-                   bool removeNamedRanges)
-                : AsyncWorker<Sheet>(callback, that, "node-libxl-remove-col"),
-                  colFirst(colFirst),
-                  colLast(colLast),
-                  removeNamedRanges(removeNamedRanges) {}
+            Worker(Nan::Callback* callback, Local<Object> that, const arrow_ipc::Options& options)
+                : AsyncWorker<Sheet>(callback, that, "node-libxl-sheet-to-arrow"),
+                  options(options) {}
 
             virtual void Execute() {
-                if (!that->GetWrapped()->removeCol(colFirst, colLast, removeNamedRanges)) {
-                    RaiseLibxlError();
+                std::string out, error;
+
+                if (!arrow_ipc::Build(util::UnwrapBook(that), that->GetWrapped(), options, &out,
+                                      &error)) {
+                    return SetErrorMessage(error.c_str());
+                }
+
+                if (!util::FitsBuffer(out.size())) {
+                    return SetErrorMessage("Arrow output exceeds the maximum buffer size");
                 }
+
+                size = out.size();
+                buffer = new char[size];
+                memcpy(buffer, out.data(), size);
+            }
+
+            virtual void HandleOKCallback() {
+                Nan::HandleScope scope;
+
+                Local<Value> argv[] = {
+                    Nan::Undefined(),
+                    Nan::NewBuffer(buffer, static_cast<uint32_t>(size)).ToLocalChecked()};
+
+                callback->Call(2, argv, async_resource);
             }
 
            private:
-            int colFirst, colLast;
-            bool removeNamedRanges;
+            arrow_ipc::Options options;
+            char* buffer{nullptr};
+            size_t size{0};
         };
 
         Nan::HandleScope scope;
 
         ArgumentHelper arguments(info);
 
-        if (arguments.Length() > 4) {
+        if (arguments.Length() > 3) {
             return Nan::ThrowError("too many arguments");
         }
 
-        int colFirst = arguments.GetInt(0), colLast = arguments.GetInt(1);
-        bool updateNamedRanges = arguments.Length() > 3 ? arguments.GetBoolean(2, true) : true;
         Local<Function> callback = arguments.GetFunction(arguments.Length() - 1);
         ASSERT_ARGUMENTS(arguments);
 
+        Local<Value> range = arguments.Length() > 1 ? info[0] : Nan::Undefined().As<Value>();
+        Local<Value> schema = arguments.Length() > 2 ? info[1] : Nan::Undefined().As<Value>();
+
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
 
-        Nan::AsyncQueueWorker(new Worker(new Nan::Callback(callback), info.This(), colFirst,
-                                         colLast, updateNamedRanges));
+        arrow_ipc::Options arrowOptions;
+        if (!arrow_ipc::ParseOptions(range, schema, that->GetWrapped(), &arrowOptions)) return;
+
+        Nan::AsyncQueueWorker(new Worker(new Nan::Callback(callback), info.This(), arrowOptions));
 
         info.GetReturnValue().Set(info.This());
     }
 
-    NAN_METHOD(Sheet::RemoveCol) {
+    NAN_METHOD(Sheet::ReadFormattedAsync) {
+        class Worker : public AsyncWorker<Sheet> {
+           public:
+            Worker(Nan::Callback* callback, Local<Object> that, const CellRange& range)
+                : AsyncWorker<Sheet>(callback, that, "node-libxl-sheet-read-formatted"),
+                  range(range) {}
+
+            virtual void Execute() {
+                Book* book = that->GetBook();
+                std::string error;
+
+                if (!book->GetNumberFormatCache().Render(book->GetWrapped(), that->GetWrapped(),
+                                                         range, &data, &offsets, &error)) {
+                    SetErrorMessage(error.c_str());
+                }
+            }
+
+            virtual void HandleOKCallback() {
+                Nan::HandleScope scope;
+
+                int rows = range.Rows(), cols = range.Cols();
+                Local<Array> result = Nan::New<Array>(rows);
+
+                for (int i = 0; i < rows; i++) {
+                    Local<Array> row = Nan::New<Array>(cols);
+
+                    for (int j = 0; j < cols; j++) {
+                        size_t cell = static_cast<size_t>(i) * cols + j;
+
+                        Nan::Set(row, j,
+                                 Nan::New<String>(data.data() + offsets[cell],
+                                                  offsets[cell + 1] - offsets[cell])
+                                     .ToLocalChecked());
+                    }
+
+                    Nan::Set(result, i, row);
+                }
+
+                Local<Value> argv[] = {Nan::Undefined(), result};
+
+                callback->Call(2, argv, async_resource);
+            }
+
+           private:
+            CellRange range;
+            std::string data;
+            std::vector<uint32_t> offsets;
+        };
+
         Nan::HandleScope scope;
 
         ArgumentHelper arguments(info);
 
-        int colFirst = arguments.GetInt(0), colLast = arguments.GetInt(1);
-        bool updateNamedRanges = arguments.GetBoolean(2, true);
+        if (arguments.Length() > 2) {
+            return Nan::ThrowError("too many arguments");
+        }
+
+        Local<Function> callback = arguments.GetFunction(arguments.Length() - 1);
         ASSERT_ARGUMENTS(arguments);
 
+        Local<Value> rangeValue = arguments.Length() > 1 ? info[0] : Nan::Undefined().As<Value>();
+
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
 
-        if (!that->GetWrapped()->removeCol(colFirst, colLast, updateNamedRanges)) {
-            return util::ThrowLibxlError(that);
+        CellRange range;
+
+        if (!cell_range::Parse(rangeValue->IsNull() ? Nan::Undefined().As<Value>() : rangeValue,
+                               that->GetWrapped(), &range)) {
+            return;
         }
 
+        Nan::AsyncQueueWorker(new Worker(new Nan::Callback(callback), info.This(), range));
+
         info.GetReturnValue().Set(info.This());
     }
 
     NAN_METHOD(Sheet::CopyCell) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int rowSrc = arguments.GetInt(0), colSrc = arguments.GetInt(1),
-            rowDst = arguments.GetInt(2), colDst = arguments.GetInt(3);
+        Args<int, int, int, int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [rowSrc, colSrc, rowDst, colDst] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -1852,10 +2338,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::SetZoom) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int zoom = arguments.GetInt(0);
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [zoom] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -1880,10 +2365,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::SetPrintZoom) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int zoom = arguments.GetInt(0);
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [zoom] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -1904,10 +2388,8 @@ namespace node_libxl {
         if (that->GetWrapped()->getPrintFit(&wPages, &hPages)) {
             Local<Object> result = Nan::New<Object>();
 
-            Nan::Set(result, Nan::New<String>("wPages").ToLocalChecked(),
-                     Nan::New<Integer>(wPages));
-            Nan::Set(result, Nan::New<String>("hPages").ToLocalChecked(),
-                     Nan::New<Integer>(hPages));
+            Nan::Set(result, keys::Get(keys::wPages), Nan::New<Integer>(wPages));
+            Nan::Set(result, keys::Get(keys::hPages), Nan::New<Integer>(hPages));
 
             info.GetReturnValue().Set(result);
         } else {
@@ -2144,10 +2626,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::SetMarginLeft) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        double margin = arguments.GetDouble(0);
+        Args<double> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [margin] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -2172,10 +2653,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::SetMarginRight) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        double margin = arguments.GetDouble(0);
+        Args<double> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [margin] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -2200,10 +2680,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::SetMarginTop) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        double margin = arguments.GetDouble(0);
+        Args<double> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [margin] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -2228,10 +2707,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::SetMarginBottom) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        double margin = arguments.GetDouble(0);
+        Args<double> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [margin] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -2285,9 +2763,8 @@ namespace node_libxl {
         }
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("rowFirst").ToLocalChecked(),
-                 Nan::New<Integer>(rowFirst));
-        Nan::Set(result, Nan::New<String>("rowLast").ToLocalChecked(), Nan::New<Integer>(rowLast));
+        Nan::Set(result, keys::Get(keys::rowFirst), Nan::New<Integer>(rowFirst));
+        Nan::Set(result, keys::Get(keys::rowLast), Nan::New<Integer>(rowLast));
 
         info.GetReturnValue().Set(result);
     }
@@ -2295,10 +2772,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::SetPrintRepeatRows) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int rowFirst = arguments.GetInt(0), rowLast = arguments.GetInt(1);
+        Args<int, int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [rowFirst, rowLast] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -2324,9 +2800,8 @@ namespace node_libxl {
         }
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("colFirst").ToLocalChecked(),
-                 Nan::New<Integer>(colFirst));
-        Nan::Set(result, Nan::New<String>("colLast").ToLocalChecked(), Nan::New<Integer>(colLast));
+        Nan::Set(result, keys::Get(keys::colFirst), Nan::New<Integer>(colFirst));
+        Nan::Set(result, keys::Get(keys::colLast), Nan::New<Integer>(colLast));
 
         info.GetReturnValue().Set(result);
     }
@@ -2334,10 +2809,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::SetPrintRepeatCols) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int colFirst = arguments.GetInt(0), colLast = arguments.GetInt(1);
+        Args<int, int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [colFirst, colLast] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -2350,11 +2824,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::SetPrintArea) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int rowFirst = arguments.GetInt(0), rowLast = arguments.GetInt(1),
-            colFirst = arguments.GetInt(2), colLast = arguments.GetInt(3);
+        Args<int, int, int, int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [rowFirst, rowLast, colFirst, colLast] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -2414,13 +2886,11 @@ namespace node_libxl {
 
         Local<Object> result = Nan::New<Object>();
 
-        Nan::Set(result, Nan::New<String>("rowFirst").ToLocalChecked(),
-                 Nan::New<Integer>(rowFirst));
-        Nan::Set(result, Nan::New<String>("rowLast").ToLocalChecked(), Nan::New<Integer>(rowLast));
-        Nan::Set(result, Nan::New<String>("colFirst").ToLocalChecked(),
-                 Nan::New<Integer>(colFirst));
-        Nan::Set(result, Nan::New<String>("colLast").ToLocalChecked(), Nan::New<Integer>(colLast));
-        Nan::Set(result, Nan::New<String>("hidden").ToLocalChecked(), Nan::New<Boolean>(hidden));
+        Nan::Set(result, keys::Get(keys::rowFirst), Nan::New<Integer>(rowFirst));
+        Nan::Set(result, keys::Get(keys::rowLast), Nan::New<Integer>(rowLast));
+        Nan::Set(result, keys::Get(keys::colFirst), Nan::New<Integer>(colFirst));
+        Nan::Set(result, keys::Get(keys::colLast), Nan::New<Integer>(colLast));
+        Nan::Set(result, keys::Get(keys::hidden), Nan::New<Boolean>(hidden));
 
         info.GetReturnValue().Set(result);
     }
@@ -2466,18 +2936,13 @@ namespace node_libxl {
         }
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("rowFirst").ToLocalChecked(),
-                 Nan::New<Integer>(rowFirst));
-        Nan::Set(result, Nan::New<String>("rowLast").ToLocalChecked(), Nan::New<Integer>(rowLast));
-        Nan::Set(result, Nan::New<String>("colFirst").ToLocalChecked(),
-                 Nan::New<Integer>(colFirst));
-        Nan::Set(result, Nan::New<String>("colLast").ToLocalChecked(), Nan::New<Integer>(colLast));
-        Nan::Set(result, Nan::New<String>("rowFirst").ToLocalChecked(),
-                 Nan::New<Integer>(rowFirst));
-        Nan::Set(result, Nan::New<String>("totalRowCount").ToLocalChecked(),
-                 Nan::New<Integer>(headerRowCount));
-        Nan::Set(result, Nan::New<String>("totalRowCount").ToLocalChecked(),
-                 Nan::New<Integer>(rowFirst));
+        Nan::Set(result, keys::Get(keys::rowFirst), Nan::New<Integer>(rowFirst));
+        Nan::Set(result, keys::Get(keys::rowLast), Nan::New<Integer>(rowLast));
+        Nan::Set(result, keys::Get(keys::colFirst), Nan::New<Integer>(colFirst));
+        Nan::Set(result, keys::Get(keys::colLast), Nan::New<Integer>(colLast));
+        Nan::Set(result, keys::Get(keys::rowFirst), Nan::New<Integer>(rowFirst));
+        Nan::Set(result, keys::Get(keys::totalRowCount), Nan::New<Integer>(headerRowCount));
+        Nan::Set(result, keys::Get(keys::totalRowCount), Nan::New<Integer>(rowFirst));
 
         info.GetReturnValue().Set(result);
     }
@@ -2497,11 +2962,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::Table) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int index = arguments.GetInt(0);
-
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [index] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -2513,18 +2976,13 @@ namespace node_libxl {
         }
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("rowFirst").ToLocalChecked(),
-                 Nan::New<Integer>(rowFirst));
-        Nan::Set(result, Nan::New<String>("rowLast").ToLocalChecked(), Nan::New<Integer>(rowLast));
-        Nan::Set(result, Nan::New<String>("colFirst").ToLocalChecked(),
-                 Nan::New<Integer>(colFirst));
-        Nan::Set(result, Nan::New<String>("colLast").ToLocalChecked(), Nan::New<Integer>(colLast));
-        Nan::Set(result, Nan::New<String>("rowFirst").ToLocalChecked(),
-                 Nan::New<Integer>(rowFirst));
-        Nan::Set(result, Nan::New<String>("totalRowCount").ToLocalChecked(),
-                 Nan::New<Integer>(headerRowCount));
-        Nan::Set(result, Nan::New<String>("totalRowCount").ToLocalChecked(),
-                 Nan::New<Integer>(rowFirst));
+        Nan::Set(result, keys::Get(keys::rowFirst), Nan::New<Integer>(rowFirst));
+        Nan::Set(result, keys::Get(keys::rowLast), Nan::New<Integer>(rowLast));
+        Nan::Set(result, keys::Get(keys::colFirst), Nan::New<Integer>(colFirst));
+        Nan::Set(result, keys::Get(keys::colLast), Nan::New<Integer>(colLast));
+        Nan::Set(result, keys::Get(keys::rowFirst), Nan::New<Integer>(rowFirst));
+        Nan::Set(result, keys::Get(keys::totalRowCount), Nan::New<Integer>(headerRowCount));
+        Nan::Set(result, keys::Get(keys::totalRowCount), Nan::New<Integer>(rowFirst));
 
         info.GetReturnValue().Set(result);
     }
@@ -2544,10 +3002,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::Hyperlink) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int index = arguments.GetInt(0);
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [index] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -2561,14 +3018,11 @@ namespace node_libxl {
         }
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("hyperlink").ToLocalChecked(),
-                 Nan::New<String>(hyperlink).ToLocalChecked());
-        Nan::Set(result, Nan::New<String>("rowFirst").ToLocalChecked(),
-                 Nan::New<Integer>(rowFirst));
-        Nan::Set(result, Nan::New<String>("rowLast").ToLocalChecked(), Nan::New<Integer>(rowLast));
-        Nan::Set(result, Nan::New<String>("colFirst").ToLocalChecked(),
-                 Nan::New<Integer>(colFirst));
-        Nan::Set(result, Nan::New<String>("colLast").ToLocalChecked(), Nan::New<Integer>(colLast));
+        Nan::Set(result, keys::Get(keys::hyperlink), Nan::New<String>(hyperlink).ToLocalChecked());
+        Nan::Set(result, keys::Get(keys::rowFirst), Nan::New<Integer>(rowFirst));
+        Nan::Set(result, keys::Get(keys::rowLast), Nan::New<Integer>(rowLast));
+        Nan::Set(result, keys::Get(keys::colFirst), Nan::New<Integer>(colFirst));
+        Nan::Set(result, keys::Get(keys::colLast), Nan::New<Integer>(colLast));
 
         info.GetReturnValue().Set(result);
     }
@@ -2576,9 +3030,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::DelHyperlink) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-        int index = arguments.GetInt(0);
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [index] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -2613,11 +3067,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::HyperlinkIndex) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0);
-        int col = arguments.GetInt(1);
+        Args<int, int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row, col] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -2718,10 +3170,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::NamedRange) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int index = arguments.GetInt(0);
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [index] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -2737,16 +3188,13 @@ namespace node_libxl {
 
         Local<Object> result = Nan::New<Object>();
 
-        Nan::Set(result, Nan::New<String>("name").ToLocalChecked(),
-                 Nan::New<String>(name).ToLocalChecked());
-        Nan::Set(result, Nan::New<String>("rowFirst").ToLocalChecked(),
-                 Nan::New<Integer>(rowFirst));
-        Nan::Set(result, Nan::New<String>("rowLast").ToLocalChecked(), Nan::New<Integer>(rowLast));
-        Nan::Set(result, Nan::New<String>("colFirst").ToLocalChecked(),
-                 Nan::New<Integer>(colFirst));
-        Nan::Set(result, Nan::New<String>("colLast").ToLocalChecked(), Nan::New<Integer>(colLast));
-        Nan::Set(result, Nan::New<String>("scopeId").ToLocalChecked(), Nan::New<Integer>(scopeId));
-        Nan::Set(result, Nan::New<String>("hidden").ToLocalChecked(), Nan::New<Boolean>(hidden));
+        Nan::Set(result, keys::Get(keys::name), Nan::New<String>(name).ToLocalChecked());
+        Nan::Set(result, keys::Get(keys::rowFirst), Nan::New<Integer>(rowFirst));
+        Nan::Set(result, keys::Get(keys::rowLast), Nan::New<Integer>(rowLast));
+        Nan::Set(result, keys::Get(keys::colFirst), Nan::New<Integer>(colFirst));
+        Nan::Set(result, keys::Get(keys::colLast), Nan::New<Integer>(colLast));
+        Nan::Set(result, keys::Get(keys::scopeId), Nan::New<Integer>(scopeId));
+        Nan::Set(result, keys::Get(keys::hidden), Nan::New<Boolean>(hidden));
 
         info.GetReturnValue().Set(result);
     }
@@ -2876,8 +3324,8 @@ namespace node_libxl {
 
         Local<Object> result = Nan::New<Object>();
 
-        Nan::Set(result, Nan::New<String>("row").ToLocalChecked(), Nan::New<Integer>(row));
-        Nan::Set(result, Nan::New<String>("col").ToLocalChecked(), Nan::New<Integer>(col));
+        Nan::Set(result, keys::Get(keys::row), Nan::New<Integer>(row));
+        Nan::Set(result, keys::Get(keys::col), Nan::New<Integer>(col));
 
         info.GetReturnValue().Set(result);
     }
@@ -2885,10 +3333,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::SetTopLeftView) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0), col = arguments.GetInt(1);
+        Args<int, int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row, col] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -2915,12 +3362,10 @@ namespace node_libxl {
         that->GetWrapped()->addrToRowCol(*addr, &row, &col, &rowRelative, &colRelative);
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("row").ToLocalChecked(), Nan::New<Integer>(row));
-        Nan::Set(result, Nan::New<String>("col").ToLocalChecked(), Nan::New<Integer>(col));
-        Nan::Set(result, Nan::New<String>("rowRelative").ToLocalChecked(),
-                 Nan::New<Boolean>(rowRelative));
-        Nan::Set(result, Nan::New<String>("colRelative").ToLocalChecked(),
-                 Nan::New<Boolean>(colRelative));
+        Nan::Set(result, keys::Get(keys::row), Nan::New<Integer>(row));
+        Nan::Set(result, keys::Get(keys::col), Nan::New<Integer>(col));
+        Nan::Set(result, keys::Get(keys::rowRelative), Nan::New<Boolean>(rowRelative));
+        Nan::Set(result, keys::Get(keys::colRelative), Nan::New<Boolean>(colRelative));
 
         info.GetReturnValue().Set(result);
     }
@@ -2947,6 +3392,132 @@ namespace node_libxl {
         info.GetReturnValue().Set(Nan::New<String>(addr).ToLocalChecked());
     }
 
+    NAN_METHOD(Sheet::AddrsToRowCols) {
+        Nan::HandleScope scope;
+
+        bool packed = info.Length() == 2;
+
+        if (info.Length() < 1 || info.Length() > 2) {
+            return Nan::ThrowError("one or two arguments required");
+        }
+
+        if (packed ? !node::Buffer::HasInstance(info[0]) || !info[1]->IsUint32Array()
+                   : !info[0]->IsArray()) {
+            return Nan::ThrowTypeError(
+                "array of addresses or buffer and Uint32Array of offsets required");
+        }
+
+        Sheet* that = FromJS(info.This());
+        ASSERT_SHEET(that);
+
+        std::vector<int32_t> rows, cols;
+        std::vector<uint8_t> rowRelatives, colRelatives;
+
+        auto add = [&](const char* addr, size_t length) {
+            int row = -1, col = -1;
+            bool rowRelative = true, colRelative = true;
+
+            if (!cell_address::Parse(addr, length, &row, &col, &rowRelative, &colRelative)) {
+                row = col = -1;
+                rowRelative = colRelative = true;
+            }
+
+            rows.push_back(row);
+            cols.push_back(col);
+            rowRelatives.push_back(rowRelative);
+            colRelatives.push_back(colRelative);
+        };
+
+        if (packed) {
+            // Address i spans offsets[i] to offsets[i + 1]
+            const char* data = node::Buffer::Data(info[0]);
+            size_t size = node::Buffer::Length(info[0]);
+            Nan::TypedArrayContents<uint32_t> offsets(info[1]);
+
+            for (size_t i = 0; i + 1 < offsets.length(); i++) {
+                uint32_t begin = (*offsets)[i], end = (*offsets)[i + 1];
+
+                if (begin > end || end > size) {
+                    return Nan::ThrowTypeError("offsets out of range");
+                }
+
+                add(data + begin, end - begin);
+            }
+        } else {
+            Local<Array> addrs = info[0].As<Array>();
+
+            for (uint32_t i = 0; i < addrs->Length(); i++) {
+                Local<Value> element;
+                if (!Nan::Get(addrs, i).ToLocal(&element)) return;
+
+                if (!element->IsString()) {
+                    return Nan::ThrowTypeError("addresses must be strings");
+                }
+
+                CSNanUtf8Value(addr, element);
+                add(*addr, addr.length());
+            }
+        }
+
+        Local<Object> result = Nan::New<Object>();
+        Nan::Set(result, keys::Get(keys::row),
+                 util::NewTypedArray<Int32Array>(rows.data(), rows.size()));
+        Nan::Set(result, keys::Get(keys::col),
+                 util::NewTypedArray<Int32Array>(cols.data(), cols.size()));
+        Nan::Set(result, keys::Get(keys::rowRelative),
+                 util::NewTypedArray<Uint8Array>(rowRelatives.data(), rowRelatives.size()));
+        Nan::Set(result, keys::Get(keys::colRelative),
+                 util::NewTypedArray<Uint8Array>(colRelatives.data(), colRelatives.size()));
+
+        info.GetReturnValue().Set(result);
+    }
+
+    NAN_METHOD(Sheet::RowColsToAddrs) {
+        Nan::HandleScope scope;
+
+        ArgumentHelper arguments(info);
+
+        bool rowRelative = arguments.GetBoolean(2, true),
+             colRelative = arguments.GetBoolean(3, true);
+        ASSERT_ARGUMENTS(arguments);
+
+        if (!info[0]->IsInt32Array() || !info[1]->IsInt32Array()) {
+            return Nan::ThrowTypeError("Int32Array of rows and cols required");
+        }
+
+        Nan::TypedArrayContents<int32_t> rows(info[0]), cols(info[1]);
+
+        if (rows.length() != cols.length()) {
+            return Nan::ThrowTypeError("rows and cols must have the same length");
+        }
+
+        Sheet* that = FromJS(info.This());
+        ASSERT_SHEET(that);
+
+        std::string data;
+        std::vector<uint32_t> offsets{0};
+
+        data.reserve(rows.length() * 8);
+        offsets.reserve(rows.length() + 1);
+
+        for (size_t i = 0; i < rows.length(); i++) {
+            if ((*rows)[i] < 0 || (*cols)[i] < 0) {
+                return Nan::ThrowTypeError("rows and cols must not be negative");
+            }
+
+            cell_address::Append(&data, (*rows)[i], (*cols)[i], rowRelative, colRelative);
+            offsets.push_back(data.size());
+        }
+
+        Local<Object> result = Nan::New<Object>();
+        Nan::Set(result, keys::Get(keys::data),
+                 Nan::CopyBuffer(data.data(), data.size()).ToLocalChecked());
+        Nan::Set(result, keys::Get(keys::offsets),
+                 util::NewTypedArray<Uint32Array>(offsets.data(), offsets.size()));
+
+        info.GetReturnValue().Set(result);
+    }
+
     NAN_METHOD(Sheet::SetAutoFitArea) {
         Nan::HandleScope scope;
 
@@ -3028,9 +3599,9 @@ namespace node_libxl {
         }
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("red").ToLocalChecked(), Nan::New<Integer>(red));
-        Nan::Set(result, Nan::New<String>("green").ToLocalChecked(), Nan::New<Integer>(green));
-        Nan::Set(result, Nan::New<String>("blue").ToLocalChecked(), Nan::New<Integer>(blue));
+        Nan::Set(result, keys::Get(keys::red), Nan::New<Integer>(red));
+        Nan::Set(result, keys::Get(keys::green), Nan::New<Integer>(green));
+        Nan::Set(result, keys::Get(keys::blue), Nan::New<Integer>(blue));
 
         info.GetReturnValue().Set(result);
     }
@@ -3038,14 +3609,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::AddIgnoredError) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int rowFirst = arguments.GetInt(0);
-        int colFirst = arguments.GetInt(1);
-        int rowLast = arguments.GetInt(2);
-        int colLast = arguments.GetInt(3);
-        int iError = arguments.GetInt(4);
+        Args<int, int, int, int, int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [rowFirst, colFirst, rowLast, colLast, iError] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -3166,10 +3732,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::FormControl) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int index = arguments.GetInt(0);
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [index] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -3185,14 +3750,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::AddConditionalFormatting) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int rowFirst = arguments.GetInt(0);
-        int rowLast = arguments.GetInt(1);
-        int colFirst = arguments.GetInt(2);
-        int colLast = arguments.GetInt(3);
-
+        Args<int, int, int, int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [rowFirst, rowLast, colFirst, colLast] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -3250,10 +3810,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::ConditionalFormattingByIndex) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int index = arguments.GetInt(0);
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [index] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -3271,10 +3830,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::RemoveConditionalFormatting) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int index = arguments.GetInt(0);
+        Args<int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [index] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -3309,8 +3867,8 @@ namespace node_libxl {
         that->GetWrapped()->getActiveCell(&row, &col);
 
         Local<Object> result = Nan::New<Object>();
-        Nan::Set(result, Nan::New<String>("row").ToLocalChecked(), Nan::New<Integer>(row));
-        Nan::Set(result, Nan::New<String>("col").ToLocalChecked(), Nan::New<Integer>(col));
+        Nan::Set(result, keys::Get(keys::row), Nan::New<Integer>(row));
+        Nan::Set(result, keys::Get(keys::col), Nan::New<Integer>(col));
 
         info.GetReturnValue().Set(result);
     }
@@ -3318,11 +3876,9 @@ namespace node_libxl {
     NAN_METHOD(Sheet::SetActiveCell) {
         Nan::HandleScope scope;
 
-        ArgumentHelper arguments(info);
-
-        int row = arguments.GetInt(0);
-        int col = arguments.GetInt(1);
+        Args<int, int> arguments(info);
         ASSERT_ARGUMENTS(arguments);
+        auto [row, col] = arguments.Get();
 
         Sheet* that = FromJS(info.This());
         ASSERT_SHEET(that);
@@ -3445,6 +4001,95 @@ namespace node_libxl {
         info.GetReturnValue().Set(Table::NewInstance(table, that->GetBookHandle()));
     }
 
+#ifdef NODE_LIBXL_FAST_API
+
+    // Fast API variants. These run without a HandleScope and must not touch the JS heap,
+    // so anything unusual (wrong arguments, format out parameters, pending async operations,
+    // libxl errors) sets options.fallback and V8 retries through the regular implementation.
+
+    Sheet* Sheet::FastUnwrap(Local<Object> receiver) {
+        if (receiver->InternalFieldCount() < 1) return nullptr;
+
+        Nan::ObjectWrap* wrap =
+            static_cast<Nan::ObjectWrap*>(receiver->GetAlignedPointerFromInternalField(0));
+        if (!wrap) return nullptr;
+
+        Sheet* that = static_cast<Sheet*>(wrap);
+        Book* book = that->GetBook();
+
+        return book->AsyncPending() || !book->IsValidSheet(that->wrappedSheet) ? nullptr : that;
+    }
+
+    int32_t Sheet::FastCellType(Local<Object> receiver, double row, double col,
+                                v8::FastApiCallbackOptions& options) {
+        Sheet* that = FastUnwrap(receiver);
+        int r, c;
+
+        if (!that || !fast_api::ToInt(row, &r) || !fast_api::ToInt(col, &c)) {
+            options.fallback = true;
+            return 0;
+        }
+
+        libxl::CellType cellType = that->GetWrapped()->cellType(r, c);
+        if (cellType == libxl::CELLTYPE_ERROR) options.fallback = true;
+
+        return cellType;
+    }
+
+    bool Sheet::FastIsFormula(Local<Object> receiver, double row, double col,
+                              v8::FastApiCallbackOptions& options) {
+        Sheet* that = FastUnwrap(receiver);
+        int r, c;
+
+        if (!that || !fast_api::ToInt(row, &r) || !fast_api::ToInt(col, &c)) {
+            options.fallback = true;
+            return false;
+        }
+
+        return that->GetWrapped()->isFormula(r, c);
+    }
+
+    double Sheet::FastReadNum(Local<Object> receiver, double row, double col,
+                              v8::FastApiCallbackOptions& options) {
+        Sheet* that = FastUnwrap(receiver);
+        int r, c;
+
+        if (!that || !fast_api::ToInt(row, &r) || !fast_api::ToInt(col, &c)) {
+            options.fallback = true;
+            return 0;
+        }
+
+        return that->GetWrapped()->readNum(r, c);
+    }
+
+    bool Sheet::FastReadBool(Local<Object> receiver, double row, double col,
+                             v8::FastApiCallbackOptions& options) {
+        Sheet* that = FastUnwrap(receiver);
+        int r, c;
+
+        if (!that || !fast_api::ToInt(row, &r) || !fast_api::ToInt(col, &c)) {
+            options.fallback = true;
+            return false;
+        }
+
+        return that->GetWrapped()->readBool(r, c);
+    }
+
+    bool Sheet::FastIsDate(Local<Object> receiver, double row, double col,
+                           v8::FastApiCallbackOptions& options) {
+        Sheet* that = FastUnwrap(receiver);
+        int r, c;
+
+        if (!that || !fast_api::ToInt(row, &r) || !fast_api::ToInt(col, &c)) {
+            options.fallback = true;
+            return false;
+        }
+
+        return that->GetWrapped()->isDate(r, c);
+    }
+
+#endif  // NODE_LIBXL_FAST_API
+
     // Init
 
     void Sheet::Initialize(Local<Object> exports) {
@@ -3458,8 +4103,8 @@ namespace node_libxl {
 
         BookHolder::Initialize<Sheet>(t);
 
-        Nan::SetPrototypeMethod(t, "cellType", CellType);
-        Nan::SetPrototypeMethod(t, "isFormula", IsFormula);
+        SET_FAST_PROTOTYPE_METHOD(t, "cellType", CellType, FastCellType);
+        SET_FAST_PROTOTYPE_METHOD(t, "isFormula", IsFormula, FastIsFormula);
         Nan::SetPrototypeMethod(t, "cellFormat", CellFormat);
         Nan::SetPrototypeMethod(t, "setCellFormat", SetCellFormat);
         Nan::SetPrototypeMethod(t, "readStr", ReadStr);
@@ -3468,9 +4113,10 @@ namespace node_libxl {
         Nan::SetPrototypeMethod(t, "writeRichStr", WriteRichStr);
         Nan::SetPrototypeMethod(t, "writeString", WriteStr);
         Nan::SetPrototypeMethod(t, "writeStr", WriteStr);
-        Nan::SetPrototypeMethod(t, "readNum", ReadNum);
+        Nan::SetPrototypeMethod(t, "writeInterned", WriteInterned);
+        SET_FAST_PROTOTYPE_METHOD(t, "readNum", ReadNum, FastReadNum);
         Nan::SetPrototypeMethod(t, "writeNum", WriteNum);
-        Nan::SetPrototypeMethod(t, "readBool", ReadBool);
+        SET_FAST_PROTOTYPE_METHOD(t, "readBool", ReadBool, FastReadBool);
         Nan::SetPrototypeMethod(t, "writeBool", WriteBool);
         Nan::SetPrototypeMethod(t, "readBlank", ReadBlank);
         Nan::SetPrototypeMethod(t, "writeBlank", WriteBlank);
@@ -3482,7 +4128,8 @@ namespace node_libxl {
         Nan::SetPrototypeMethod(t, "readComment", ReadComment);
         Nan::SetPrototypeMethod(t, "writeComment", WriteComment);
         Nan::SetPrototypeMethod(t, "removeComment", RemoveComment);
-        Nan::SetPrototypeMethod(t, "isDate", IsDate);
+        SET_FAST_PROTOTYPE_METHOD(t, "isDate", IsDate, FastIsDate);
+        Nan::SetPrototypeMethod(t, "readCell", ReadCell);
         Nan::SetPrototypeMethod(t, "isRichStr", IsRichStr);
         Nan::SetPrototypeMethod(t, "readError", ReadError);
         Nan::SetPrototypeMethod(t, "writeError", WriteError);
@@ -3541,6 +4188,12 @@ namespace node_libxl {
         Nan::SetPrototypeMethod(t, "removeCol", RemoveCol);
         Nan::SetPrototypeMethod(t, "removeColSync", RemoveCol);
         Nan::SetPrototypeMethod(t, "removeColAsync", RemoveColAsync);
+        Nan::SetPrototypeMethod(t, "writeColumnsAsync", WriteColumnsAsync);
+        Nan::SetPrototypeMethod(t, "exportCsvAsync", ExportCsvAsync);
+        Nan::SetPrototypeMethod(t, "importCsvAsync", ImportCsvAsync);
+        Nan::SetPrototypeMethod(t, "toRecordsAsync", ToRecordsAsync);
+        Nan::SetPrototypeMethod(t, "toArrowAsync", ToArrowAsync);
+        Nan::SetPrototypeMethod(t, "readFormattedAsync", ReadFormattedAsync);
         Nan::SetPrototypeMethod(t, "copyCell", CopyCell);
         Nan::SetPrototypeMethod(t, "firstRow", FirstRow);
         Nan::SetPrototypeMethod(t, "lastRow", LastRow);
@@ -3615,6 +4268,8 @@ namespace node_libxl {
         Nan::SetPrototypeMethod(t, "setTopLeftView", SetTopLeftView);
         Nan::SetPrototypeMethod(t, "addrToRowCol", AddrToRowCol);
         Nan::SetPrototypeMethod(t, "rowColToAddr", RowColToAddr);
+        Nan::SetPrototypeMethod(t, "addrsToRowCols", AddrsToRowCols);
+        Nan::SetPrototypeMethod(t, "rowColsToAddrs", RowColsToAddrs);
         Nan::SetPrototypeMethod(t, "hyperlinkSize", HyperlinkSize);
         Nan::SetPrototypeMethod(t, "hyperlink", Hyperlink);
         Nan::SetPrototypeMethod(t, "delHyperlink", DelHyperlink);
@@ -3648,6 +4303,7 @@ namespace node_libxl {
 
         t->ReadOnlyPrototype();
         constructor.Reset(Nan::GetFunction(t).ToLocalChecked());
+        functionTemplate.Reset(t);
         Nan::Set(exports, Nan::New<String>("Sheet").ToLocalChecked(), Nan::New(constructor));
     }
 
@@ -27,6 +27,7 @@
 
 #include "book_holder.h"
 #include "common.h"
+#include "fast_api.h"
 #include "wrapper.h"
 
 namespace node_libxl {
@@ -49,6 +50,7 @@ namespace node_libxl {
         static NAN_METHOD(SetCellFormat);
         static NAN_METHOD(ReadStr);
         static NAN_METHOD(WriteStr);
+        static NAN_METHOD(WriteInterned);
         static NAN_METHOD(ReadRichStr);
         static NAN_METHOD(WriteRichStr);
         static NAN_METHOD(ReadNum);
@@ -66,6 +68,7 @@ namespace node_libxl {
         static NAN_METHOD(WriteComment);
         static NAN_METHOD(RemoveComment);
         static NAN_METHOD(IsDate);
+        static NAN_METHOD(ReadCell);
         static NAN_METHOD(IsRichStr);
         static NAN_METHOD(ReadError);
         static NAN_METHOD(WriteError);
@@ -120,6 +123,12 @@ namespace node_libxl {
         static NAN_METHOD(RemoveRowAsync);
         static NAN_METHOD(RemoveCol);
         static NAN_METHOD(RemoveColAsync);
+        static NAN_METHOD(WriteColumnsAsync);
+        static NAN_METHOD(ExportCsvAsync);
+        static NAN_METHOD(ImportCsvAsync);
+        static NAN_METHOD(ToRecordsAsync);
+        static NAN_METHOD(ToArrowAsync);
+        static NAN_METHOD(ReadFormattedAsync);
         static NAN_METHOD(CopyCell);
         static NAN_METHOD(FirstRow);
         static NAN_METHOD(LastRow);
@@ -199,6 +208,8 @@ namespace node_libxl {
         static NAN_METHOD(SetTopLeftView);
         static NAN_METHOD(AddrToRowCol);
         static NAN_METHOD(RowColToAddr);
+        static NAN_METHOD(AddrsToRowCols);
+        static NAN_METHOD(RowColsToAddrs);
         static NAN_METHOD(SetAutoFitArea);
         static NAN_METHOD(TabColor);
         static NAN_METHOD(SetTabColor);
@@ -225,6 +236,21 @@ namespace node_libxl {
         static NAN_METHOD(GetTableByName);
         static NAN_METHOD(GetTableByIndex);
 
+#ifdef NODE_LIBXL_FAST_API
+        static Sheet* FastUnwrap(v8::Local<v8::Object> receiver);
+
+        static int32_t FastCellType(v8::Local<v8::Object> receiver, double row, double col,
+                                    v8::FastApiCallbackOptions& options);
+        static bool FastIsFormula(v8::Local<v8::Object> receiver, double row, double col,
+                                  v8::FastApiCallbackOptions& options);
+        static double FastReadNum(v8::Local<v8::Object> receiver, double row, double col,
+                                  v8::FastApiCallbackOptions& options);
+        static bool FastReadBool(v8::Local<v8::Object> receiver, double row, double col,
+                                 v8::FastApiCallbackOptions& options);
+        static bool FastIsDate(v8::Local<v8::Object> receiver, double row, double col,
+                               v8::FastApiCallbackOptions& options);
+#endif
+
        private:
         const libxl::Sheet* wrappedSheet;
 
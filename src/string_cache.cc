@@ -0,0 +1,76 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "string_cache.h"
+
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+using namespace v8;
+
+namespace node_libxl {
+
+    StringCache::StringCache() {}
+
+    void StringCache::SetCapacity(size_t capacity) {
+        entries.reset(capacity > 0 ? new Entry[capacity] : nullptr);
+
+        this->capacity = capacity;
+        size = hits = misses = 0;
+    }
+
+    Local<String> StringCache::Get(const char* value) {
+        size_t length = strlen(value);
+
+        if (capacity == 0 || length > maxLength) {
+            return Nan::New<String>(value, static_cast<int>(length)).ToLocalChecked();
+        }
+
+        std::string_view key(value, length);
+        size_t hash = std::hash<std::string_view>()(key);
+        Entry& entry = entries[hash % capacity];
+
+        if (!entry.string.IsEmpty() && entry.hash == hash && entry.value == key) {
+            hits++;
+            return Nan::New(entry.string);
+        }
+
+        misses++;
+
+        Isolate* isolate = Isolate::GetCurrent();
+        Local<String> string =
+            String::NewFromUtf8(isolate, value, NewStringType::kInternalized, length)
+                .ToLocalChecked();
+
+        if (entry.string.IsEmpty()) size++;
+
+        entry.hash = hash;
+        entry.value.assign(value, length);
+        entry.string.Reset(string);
+
+        return string;
+    }
+
+}  // namespace node_libxl
@@ -0,0 +1,77 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BINDINGS_STRING_CACHE_H
+#define BINDINGS_STRING_CACHE_H
+
+#include <nan.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace node_libxl {
+
+    // Direct mapped cache from UTF-8 cell contents to internalized JS strings. Repeated
+    // values (statuses, currencies, ...) read from a book map to the same v8::String,
+    // saving the transcoding and the allocation. A capacity of zero disables the cache.
+    class StringCache {
+       public:
+        // Upper bound for the capacity; the empty slots alone take about 50 MB
+        static const size_t maxCapacity = 1 << 20;
+
+        StringCache();
+
+        // capacity must not exceed maxCapacity
+        void SetCapacity(size_t capacity);
+        size_t Capacity() const { return capacity; }
+        size_t Size() const { return size; }
+        uint64_t Hits() const { return hits; }
+        uint64_t Misses() const { return misses; }
+
+        v8::Local<v8::String> Get(const char* value);
+
+       private:
+        StringCache(const StringCache&) = delete;
+        StringCache& operator=(const StringCache&) = delete;
+
+        // Longer strings are rarely repeated and would pin a lot of memory.
+        static const size_t maxLength = 256;
+
+        struct Entry {
+            size_t hash{0};
+            std::string value;
+            Nan::Global<v8::String> string;
+        };
+
+        std::unique_ptr<Entry[]> entries;
+        size_t capacity{0};
+        size_t size{0};
+        uint64_t hits{0};
+        uint64_t misses{0};
+    };
+
+}  // namespace node_libxl
+
+#endif  // BINDINGS_STRING_CACHE_H
@@ -24,36 +24,20 @@
 
 #include "string_copy.h"
 
-#include <cstring>
-
-#include "csnan.h"
+#include "utf8_value.h"
 
 using namespace v8;
 
 namespace node_libxl {
-    StringCopy::StringCopy(String::Utf8Value& utf8Value) {
-        str = new char[strlen(*utf8Value) + 1];
-        strcpy(str, *utf8Value);
-    }
-
-    StringCopy::StringCopy(Local<Value> value) {
-        String::Utf8Value utf8Value(v8::Isolate::GetCurrent(), value);
-
-        str = new char[strlen(*utf8Value) + 1];
-        strcpy(str, *utf8Value);
-    }
+    StringCopy::StringCopy(Local<Value> value)
+        : str(EncodeUtf8(value, inlineBuffer, inlineSize)) {}
 
     StringCopy::StringCopy(std::optional<v8::Local<v8::Value>> value) {
-        if (value) {
-            String::Utf8Value utf8Value(v8::Isolate::GetCurrent(), *value);
-
-            str = new char[strlen(*utf8Value) + 1];
-            strcpy(str, *utf8Value);
-        }
+        if (value) str = EncodeUtf8(*value, inlineBuffer, inlineSize);
     }
 
     StringCopy::~StringCopy() {
-        if (str) delete[] str;
+        if (str != inlineBuffer) delete[] str;
     }
 
     char* StringCopy::operator*() { return str; }
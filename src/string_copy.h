@@ -33,7 +33,6 @@ namespace node_libxl {
 
     class StringCopy {
        public:
-        explicit StringCopy(v8::String::Utf8Value& utf8Value);
         explicit StringCopy(v8::Local<v8::Value> value);
         explicit StringCopy(std::optional<v8::Local<v8::Value>> value);
 
@@ -47,7 +46,12 @@ namespace node_libxl {
         StringCopy& operator=(const StringCopy&);
         StringCopy& operator=(StringCopy&&);
 
+        // Short strings (file names, sheet names, ...) are stored inline in the worker
+        // that owns the copy, longer ones go to the heap.
+        static const size_t inlineSize = 64;
+
         char* str{nullptr};
+        char inlineBuffer[inlineSize];
     };
 
 }  // namespace node_libxl
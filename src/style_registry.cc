@@ -0,0 +1,390 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "style_registry.h"
+
+#include <cstring>
+
+#include "font.h"
+
+namespace node_libxl {
+
+    namespace {
+
+        // Excel numbers custom number formats starting from 164
+        const int firstCustomNumFormat = 164;
+
+        void AppendInt(std::string* key, int value) {
+            key->append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+    }  // namespace
+
+    // FontDescriptor
+
+    FontDescriptor FontDescriptor::Read(libxl::Font* font) {
+        FontDescriptor descriptor;
+
+        const char* name = font->name();
+        if (name) descriptor.name = name;
+
+        descriptor.size = font->size();
+        descriptor.italic = font->italic();
+        descriptor.strikeOut = font->strikeOut();
+        descriptor.color = font->color();
+        descriptor.bold = font->bold();
+        descriptor.script = font->script();
+        descriptor.underline = font->underline();
+
+        return descriptor;
+    }
+
+    void FontDescriptor::Merge(const FontSpec& spec) {
+        if (spec.name) name = *spec.name;
+        if (spec.size) size = *spec.size;
+        if (spec.italic) italic = *spec.italic;
+        if (spec.strikeOut) strikeOut = *spec.strikeOut;
+        if (spec.color) color = *spec.color;
+        if (spec.bold) bold = *spec.bold;
+        if (spec.script) script = *spec.script;
+        if (spec.underline) underline = *spec.underline;
+    }
+
+    void FontDescriptor::AppendKey(std::string* key) const {
+        AppendInt(key, size);
+        AppendInt(key, color);
+        AppendInt(key, script);
+        AppendInt(key, underline);
+        AppendInt(key, italic | strikeOut << 1 | bold << 2);
+        AppendInt(key, name.size());
+        key->append(name);
+    }
+
+    std::string FontDescriptor::Key() const {
+        std::string key;
+        key.reserve(32 + name.size());
+
+        AppendKey(&key);
+
+        return key;
+    }
+
+    // FormatDescriptor
+
+    FormatDescriptor FormatDescriptor::Read(libxl::Format* format) {
+        FormatDescriptor descriptor;
+
+        libxl::Font* font = format->font();
+        if (font) descriptor.font = FontDescriptor::Read(font);
+
+        descriptor.numFormat = format->numFormat();
+        descriptor.alignH = format->alignH();
+        descriptor.alignV = format->alignV();
+        descriptor.wrap = format->wrap();
+        descriptor.rotation = format->rotation();
+        descriptor.indent = format->indent();
+        descriptor.shrinkToFit = format->shrinkToFit();
+        descriptor.borderLeft = format->borderLeft();
+        descriptor.borderRight = format->borderRight();
+        descriptor.borderTop = format->borderTop();
+        descriptor.borderBottom = format->borderBottom();
+        descriptor.borderLeftColor = format->borderLeftColor();
+        descriptor.borderRightColor = format->borderRightColor();
+        descriptor.borderTopColor = format->borderTopColor();
+        descriptor.borderBottomColor = format->borderBottomColor();
+        descriptor.borderDiagonal = format->borderDiagonal();
+        descriptor.borderDiagonalColor = format->borderDiagonalColor();
+        descriptor.fillPattern = format->fillPattern();
+        descriptor.patternBackgroundColor = format->patternBackgroundColor();
+        descriptor.patternForegroundColor = format->patternForegroundColor();
+        descriptor.locked = format->locked();
+        descriptor.hidden = format->hidden();
+
+        return descriptor;
+    }
+
+    void FormatDescriptor::Merge(const FormatSpec& spec) {
+        if (spec.fontObject) {
+            font = FontDescriptor::Read(spec.fontObject->GetWrapped());
+        } else if (spec.font) {
+            font.Merge(*spec.font);
+        }
+
+        if (spec.numFormat) numFormat = *spec.numFormat;
+        if (spec.alignH) alignH = *spec.alignH;
+        if (spec.alignV) alignV = *spec.alignV;
+        if (spec.wrap) wrap = *spec.wrap;
+        if (spec.rotation) rotation = *spec.rotation;
+        if (spec.indent) indent = *spec.indent;
+        if (spec.shrinkToFit) shrinkToFit = *spec.shrinkToFit;
+
+        if (spec.border) borderLeft = borderRight = borderTop = borderBottom = *spec.border;
+        if (spec.borderColor) {
+            borderLeftColor = borderRightColor = borderTopColor = borderBottomColor =
+                *spec.borderColor;
+        }
+
+        if (spec.borderLeft) borderLeft = *spec.borderLeft;
+        if (spec.borderRight) borderRight = *spec.borderRight;
+        if (spec.borderTop) borderTop = *spec.borderTop;
+        if (spec.borderBottom) borderBottom = *spec.borderBottom;
+        if (spec.borderLeftColor) borderLeftColor = *spec.borderLeftColor;
+        if (spec.borderRightColor) borderRightColor = *spec.borderRightColor;
+        if (spec.borderTopColor) borderTopColor = *spec.borderTopColor;
+        if (spec.borderBottomColor) borderBottomColor = *spec.borderBottomColor;
+        if (spec.borderDiagonal) borderDiagonal = *spec.borderDiagonal;
+        if (spec.borderDiagonalColor) borderDiagonalColor = *spec.borderDiagonalColor;
+        if (spec.fillPattern) fillPattern = *spec.fillPattern;
+        if (spec.patternBackgroundColor) patternBackgroundColor = *spec.patternBackgroundColor;
+        if (spec.patternForegroundColor) patternForegroundColor = *spec.patternForegroundColor;
+        if (spec.locked) locked = *spec.locked;
+        if (spec.hidden) hidden = *spec.hidden;
+    }
+
+    std::string FormatDescriptor::Key() const {
+        std::string key;
+        key.reserve(160);
+
+        for (int value : {numFormat, alignH, alignV, rotation, indent, borderLeft, borderRight,
+                          borderTop, borderBottom, borderLeftColor, borderRightColor,
+                          borderTopColor, borderBottomColor, borderDiagonal, borderDiagonalColor,
+                          fillPattern, patternBackgroundColor, patternForegroundColor}) {
+            AppendInt(&key, value);
+        }
+
+        AppendInt(&key, wrap | shrinkToFit << 1 | locked << 2 | hidden << 3);
+        font.AppendKey(&key);
+
+        return key;
+    }
+
+    // StyleRegistry
+
+    libxl::Format* StyleRegistry::FormatFor(libxl::Book* book, FormatSpec spec) {
+        IndexFormats(book);
+
+        if (!ResolveNumFormat(book, &spec)) return nullptr;
+
+        // New formats are derived from the default format, so that is what the spec
+        // is relative to
+        libxl::Format* base = book->formatSize() > 0 ? book->format(0) : nullptr;
+
+        FormatDescriptor descriptor = base ? FormatDescriptor::Read(base) : FormatDescriptor();
+        descriptor.Merge(spec);
+
+        std::string key = descriptor.Key();
+
+        auto found = formats.find(key);
+        if (found != formats.end()) {
+            if (IsValid(book, found->second)) return found->second.object;
+
+            formats.erase(found);
+        }
+
+        // A font spec goes through the font registry instead of always adding a font
+        libxl::Font* font = nullptr;
+        if (spec.font) {
+            font = FontFor(book, base ? base->font() : nullptr, *spec.font);
+            if (!font) return nullptr;
+
+            spec.font.reset();
+        }
+
+        libxl::Format* format = book->addFormat(base);
+        if (!format || !style_spec::Apply(spec, book, format)) return nullptr;
+        if (font && !format->setFont(font)) return nullptr;
+
+        indexedFormats = book->formatSize();
+
+        Entry<libxl::Format> entry{format, indexedFormats - 1,
+                                   FormatDescriptor::Read(format).Key()};
+
+        // Also remember the requested key in case libxl normalized some property
+        if (entry.key != key) formats.emplace(key, entry);
+        formats.emplace(entry.key, std::move(entry));
+
+        return format;
+    }
+
+    libxl::Font* StyleRegistry::FontFor(libxl::Book* book, const FontSpec& spec) {
+        // New fonts are derived from the default font
+        return FontFor(book, book->fontSize() > 0 ? book->font(0) : nullptr, spec);
+    }
+
+    libxl::Font* StyleRegistry::FontFor(libxl::Book* book, libxl::Font* base,
+                                        const FontSpec& spec) {
+        IndexFonts(book);
+
+        FontDescriptor descriptor = base ? FontDescriptor::Read(base) : FontDescriptor();
+        descriptor.Merge(spec);
+
+        std::string key = descriptor.Key();
+
+        auto found = fonts.find(key);
+        if (found != fonts.end()) {
+            if (IsValid(book, found->second)) return found->second.object;
+
+            fonts.erase(found);
+        }
+
+        libxl::Font* font = book->addFont(base);
+        if (!font || !style_spec::Apply(spec, font)) return nullptr;
+
+        indexedFonts = book->fontSize();
+
+        Entry<libxl::Font> entry{font, indexedFonts - 1, FontDescriptor::Read(font).Key()};
+
+        if (entry.key != key) fonts.emplace(key, entry);
+        fonts.emplace(entry.key, std::move(entry));
+
+        return font;
+    }
+
+    libxl::Format* StyleRegistry::DateFormat(libxl::Book* book, bool withTime) {
+        FormatSpec spec;
+        spec.numFormat = withTime ? libxl::NUMFORMAT_CUSTOM_MDYYYY_HMM : libxl::NUMFORMAT_DATE;
+
+        return FormatFor(book, std::move(spec));
+    }
+
+    bool StyleRegistry::ResolveNumFormat(libxl::Book* book, FormatSpec* spec) {
+        if (!spec->customNumFormat) return true;
+
+        int numFormat = CustomNumFormat(book, *spec->customNumFormat);
+        if (!numFormat) return false;
+
+        spec->numFormat = numFormat;
+        spec->customNumFormat.reset();
+
+        return true;
+    }
+
+    int StyleRegistry::FormatIndex(libxl::Book* book, const libxl::Format* format) {
+        if (!format) return -1;
+
+        int size = book->formatSize();
+
+        auto found = formatIndices.find(format);
+        if (found != formatIndices.end() && found->second < size &&
+            book->format(found->second) == format) {
+            return found->second;
+        }
+
+        // Rebuild only for a stale entry or if formats were added or the book was reloaded since
+        // the last rebuild, so repeated misses against the same table stay cheap
+        libxl::Format* first = size > 0 ? book->format(0) : nullptr;
+        if (found == formatIndices.end() && size == indexedFormatIndices &&
+            first == firstIndexedFormat) {
+            return -1;
+        }
+
+        formatIndices.clear();
+        for (int i = 0; i < size; i++) formatIndices.emplace(book->format(i), i);
+        indexedFormatIndices = size;
+        firstIndexedFormat = first;
+
+        found = formatIndices.find(format);
+
+        return found == formatIndices.end() ? -1 : found->second;
+    }
+
+    void StyleRegistry::IndexFormats(libxl::Book* book) {
+        int size = book->formatSize();
+
+        // The book was reloaded
+        if (size < indexedFormats || (indexedFormats > 0 && book->format(0) != firstFormat)) {
+            formats.clear();
+            customNumFormats.clear();
+            indexedFormats = 0;
+        }
+
+        for (; indexedFormats < size; indexedFormats++) {
+            libxl::Format* format = book->format(indexedFormats);
+            if (!format) continue;
+
+            if (indexedFormats == 0) firstFormat = format;
+
+            FormatDescriptor descriptor = FormatDescriptor::Read(format);
+            std::string key = descriptor.Key();
+
+            formats.emplace(key, Entry<libxl::Format>{format, indexedFormats, key});
+
+            if (descriptor.numFormat >= firstCustomNumFormat) {
+                const char* description = book->customNumFormat(descriptor.numFormat);
+                if (description) customNumFormats.emplace(description, descriptor.numFormat);
+            }
+        }
+    }
+
+    void StyleRegistry::IndexFonts(libxl::Book* book) {
+        int size = book->fontSize();
+
+        if (size < indexedFonts || (indexedFonts > 0 && book->font(0) != firstFont)) {
+            fonts.clear();
+            indexedFonts = 0;
+        }
+
+        for (; indexedFonts < size; indexedFonts++) {
+            libxl::Font* font = book->font(indexedFonts);
+            if (!font) continue;
+
+            if (indexedFonts == 0) firstFont = font;
+
+            std::string key = FontDescriptor::Read(font).Key();
+
+            fonts.emplace(key, Entry<libxl::Font>{font, indexedFonts, key});
+        }
+    }
+
+    bool StyleRegistry::IsValid(libxl::Book* book, const Entry<libxl::Format>& entry) const {
+        int size = book->formatSize();
+
+        return entry.index < size && book->format(entry.index) == entry.object &&
+               FormatDescriptor::Read(entry.object).Key() == entry.key;
+    }
+
+    bool StyleRegistry::IsValid(libxl::Book* book, const Entry<libxl::Font>& entry) const {
+        int size = book->fontSize();
+
+        return entry.index < size && book->font(entry.index) == entry.object &&
+               FontDescriptor::Read(entry.object).Key() == entry.key;
+    }
+
+    int StyleRegistry::CustomNumFormat(libxl::Book* book, const std::string& description) {
+        auto found = customNumFormats.find(description);
+
+        if (found != customNumFormats.end()) {
+            const char* registered = book->customNumFormat(found->second);
+            if (registered && description == registered) return found->second;
+
+            customNumFormats.erase(found);
+        }
+
+        int numFormat = book->addCustomNumFormat(description.c_str());
+        if (numFormat) customNumFormats.emplace(description, numFormat);
+
+        return numFormat;
+    }
+
+}  // namespace node_libxl
@@ -0,0 +1,144 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BINDINGS_STYLE_REGISTRY_H
+#define BINDINGS_STYLE_REGISTRY_H
+
+#include <string>
+#include <unordered_map>
+
+#include "common.h"
+#include "style_spec.h"
+
+namespace node_libxl {
+
+    // The complete set of properties of a font / format, used to identify identical styles
+    struct FontDescriptor {
+        std::string name;
+        int size{0};
+        bool italic{false};
+        bool strikeOut{false};
+        int color{0};
+        bool bold{false};
+        int script{0};
+        int underline{0};
+
+        static FontDescriptor Read(libxl::Font* font);
+
+        void Merge(const FontSpec& spec);
+        void AppendKey(std::string* key) const;
+        std::string Key() const;
+    };
+
+    struct FormatDescriptor {
+        FontDescriptor font;
+        int numFormat{0};
+        int alignH{0};
+        int alignV{0};
+        bool wrap{false};
+        int rotation{0};
+        int indent{0};
+        bool shrinkToFit{false};
+        int borderLeft{0};
+        int borderRight{0};
+        int borderTop{0};
+        int borderBottom{0};
+        int borderLeftColor{0};
+        int borderRightColor{0};
+        int borderTopColor{0};
+        int borderBottomColor{0};
+        int borderDiagonal{0};
+        int borderDiagonalColor{0};
+        int fillPattern{0};
+        int patternBackgroundColor{0};
+        int patternForegroundColor{0};
+        bool locked{false};
+        bool hidden{false};
+
+        static FormatDescriptor Read(libxl::Format* format);
+
+        // Custom number formats must have been resolved to an id before
+        void Merge(const FormatSpec& spec);
+        std::string Key() const;
+    };
+
+    // Content addressed lookup of the formats and fonts in a book. Formats and fonts present in
+    // the book (loaded or added otherwise) are indexed lazily, so identical specs map to the
+    // same object instead of adding a new one each time. Entries are verified on every hit, so
+    // an object that was modified afterwards or a book that was reloaded is never matched
+    // wrongly.
+    class StyleRegistry {
+       public:
+        StyleRegistry() = default;
+
+        // Return nullptr if libxl failed to create the format / font
+        libxl::Format* FormatFor(libxl::Book* book, FormatSpec spec);
+        libxl::Font* FontFor(libxl::Book* book, const FontSpec& spec);
+
+        // Default format for date cells written by the bindings
+        libxl::Format* DateFormat(libxl::Book* book, bool withTime);
+
+        // Replace a custom number format code in spec by its id, so that repeating a code does
+        // not add it to the book again. Return false if libxl failed to add the code.
+        bool ResolveNumFormat(libxl::Book* book, FormatSpec* spec);
+
+        // Position of format in the format table of the book, -1 if not found
+        int FormatIndex(libxl::Book* book, const libxl::Format* format);
+
+       private:
+        StyleRegistry(const StyleRegistry&) = delete;
+        StyleRegistry& operator=(const StyleRegistry&) = delete;
+
+        template <typename T>
+        struct Entry {
+            T* object;
+            int index;
+            std::string key;
+        };
+
+        void IndexFormats(libxl::Book* book);
+        void IndexFonts(libxl::Book* book);
+        bool IsValid(libxl::Book* book, const Entry<libxl::Format>& entry) const;
+        bool IsValid(libxl::Book* book, const Entry<libxl::Font>& entry) const;
+        int CustomNumFormat(libxl::Book* book, const std::string& description);
+
+        // New fonts are derived from base, and spec is relative to it
+        libxl::Font* FontFor(libxl::Book* book, libxl::Font* base, const FontSpec& spec);
+
+        std::unordered_map<std::string, Entry<libxl::Format>> formats;
+        std::unordered_map<std::string, Entry<libxl::Font>> fonts;
+        std::unordered_map<std::string, int> customNumFormats;
+        std::unordered_map<const libxl::Format*, int> formatIndices;
+        int indexedFormats{0};
+        int indexedFonts{0};
+        libxl::Format* firstFormat{nullptr};
+        libxl::Font* firstFont{nullptr};
+        // Format table that formatIndices was last built from
+        int indexedFormatIndices{-1};
+        libxl::Format* firstIndexedFormat{nullptr};
+    };
+
+}  // namespace node_libxl
+
+#endif  // BINDINGS_STYLE_REGISTRY_H
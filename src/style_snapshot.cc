@@ -0,0 +1,157 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "style_snapshot.h"
+
+#include <unordered_map>
+#include <vector>
+
+#include "keys.h"
+#include "style_registry.h"
+#include "util.h"
+
+using namespace v8;
+
+namespace node_libxl {
+    namespace style_snapshot {
+
+        namespace {
+
+            template <typename A, typename E, typename D, typename M>
+            void SetColumn(Local<Object> table, keys::Key key, const std::vector<D>& rows,
+                           M D::*member) {
+                std::vector<E> column;
+                column.reserve(rows.size());
+
+                for (const D& row : rows) column.push_back(static_cast<E>(row.*member));
+
+                Nan::Set(table, keys::Get(key),
+                         util::NewTypedArray<A>(column.data(), column.size()));
+            }
+
+            template <typename D, typename M>
+            void SetInts(Local<Object> table, keys::Key key, const std::vector<D>& rows,
+                         M D::*member) {
+                SetColumn<Int32Array, int32_t>(table, key, rows, member);
+            }
+
+            template <typename D>
+            void SetFlags(Local<Object> table, keys::Key key, const std::vector<D>& rows,
+                          bool D::*member) {
+                SetColumn<Uint8Array, uint8_t>(table, key, rows, member);
+            }
+
+        }  // namespace
+
+        Local<Object> Create(libxl::Book* book) {
+            Nan::EscapableHandleScope scope;
+
+            int fontCount = book->fontSize();
+            std::vector<FontDescriptor> fonts;
+            std::unordered_map<const libxl::Font*, int> fontIndices;
+
+            fonts.reserve(fontCount);
+            fontIndices.reserve(fontCount);
+
+            for (int i = 0; i < fontCount; i++) {
+                libxl::Font* font = book->font(i);
+
+                fonts.push_back(font ? FontDescriptor::Read(font) : FontDescriptor());
+                if (font) fontIndices.emplace(font, i);
+            }
+
+            int formatCount = book->formatSize();
+            std::vector<FormatDescriptor> formats;
+            std::vector<int32_t> formatFonts;
+
+            formats.reserve(formatCount);
+            formatFonts.reserve(formatCount);
+
+            for (int i = 0; i < formatCount; i++) {
+                libxl::Format* format = book->format(i);
+                auto fontIndex = format ? fontIndices.find(format->font()) : fontIndices.end();
+
+                formats.push_back(format ? FormatDescriptor::Read(format) : FormatDescriptor());
+                formatFonts.push_back(fontIndex == fontIndices.end() ? -1 : fontIndex->second);
+            }
+
+            Local<Object> fontTable = Nan::New<Object>();
+            Local<Array> names = Nan::New<Array>(fontCount);
+
+            for (int i = 0; i < fontCount; i++) {
+                Nan::Set(names, i, Nan::New<String>(fonts[i].name).ToLocalChecked());
+            }
+
+            Nan::Set(fontTable, keys::Get(keys::name), names);
+            SetInts(fontTable, keys::size, fonts, &FontDescriptor::size);
+            SetFlags(fontTable, keys::italic, fonts, &FontDescriptor::italic);
+            SetFlags(fontTable, keys::strikeOut, fonts, &FontDescriptor::strikeOut);
+            SetInts(fontTable, keys::color, fonts, &FontDescriptor::color);
+            SetFlags(fontTable, keys::bold, fonts, &FontDescriptor::bold);
+            SetInts(fontTable, keys::script, fonts, &FontDescriptor::script);
+            SetInts(fontTable, keys::underline, fonts, &FontDescriptor::underline);
+
+            Local<Object> formatTable = Nan::New<Object>();
+
+            Nan::Set(formatTable, keys::Get(keys::font),
+                     util::NewTypedArray<Int32Array>(formatFonts.data(), formatFonts.size()));
+            SetInts(formatTable, keys::numFormat, formats, &FormatDescriptor::numFormat);
+            SetInts(formatTable, keys::alignH, formats, &FormatDescriptor::alignH);
+            SetInts(formatTable, keys::alignV, formats, &FormatDescriptor::alignV);
+            SetFlags(formatTable, keys::wrap, formats, &FormatDescriptor::wrap);
+            SetInts(formatTable, keys::rotation, formats, &FormatDescriptor::rotation);
+            SetInts(formatTable, keys::indent, formats, &FormatDescriptor::indent);
+            SetFlags(formatTable, keys::shrinkToFit, formats, &FormatDescriptor::shrinkToFit);
+            SetInts(formatTable, keys::borderLeft, formats, &FormatDescriptor::borderLeft);
+            SetInts(formatTable, keys::borderRight, formats, &FormatDescriptor::borderRight);
+            SetInts(formatTable, keys::borderTop, formats, &FormatDescriptor::borderTop);
+            SetInts(formatTable, keys::borderBottom, formats, &FormatDescriptor::borderBottom);
+            SetInts(formatTable, keys::borderLeftColor, formats,
+                    &FormatDescriptor::borderLeftColor);
+            SetInts(formatTable, keys::borderRightColor, formats,
+                    &FormatDescriptor::borderRightColor);
+            SetInts(formatTable, keys::borderTopColor, formats, &FormatDescriptor::borderTopColor);
+            SetInts(formatTable, keys::borderBottomColor, formats,
+                    &FormatDescriptor::borderBottomColor);
+            SetInts(formatTable, keys::borderDiagonal, formats, &FormatDescriptor::borderDiagonal);
+            SetInts(formatTable, keys::borderDiagonalColor, formats,
+                    &FormatDescriptor::borderDiagonalColor);
+            SetInts(formatTable, keys::fillPattern, formats, &FormatDescriptor::fillPattern);
+            SetInts(formatTable, keys::patternBackgroundColor, formats,
+                    &FormatDescriptor::patternBackgroundColor);
+            SetInts(formatTable, keys::patternForegroundColor, formats,
+                    &FormatDescriptor::patternForegroundColor);
+            SetFlags(formatTable, keys::locked, formats, &FormatDescriptor::locked);
+            SetFlags(formatTable, keys::hidden, formats, &FormatDescriptor::hidden);
+
+            Local<Object> snapshot = Nan::New<Object>();
+
+            Nan::Set(snapshot, keys::Get(keys::formats), formatTable);
+            Nan::Set(snapshot, keys::Get(keys::fonts), fontTable);
+
+            return scope.Escape(snapshot);
+        }
+
+    }  // namespace style_snapshot
+}  // namespace node_libxl
@@ -0,0 +1,193 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "style_spec.h"
+
+#include "font.h"
+#include "keys.h"
+#include "options.h"
+
+using namespace v8;
+
+namespace node_libxl {
+    namespace style_spec {
+
+        using options::GetBoolean;
+        using options::GetInt;
+        using options::GetProperty;
+        using options::GetString;
+
+        bool Parse(Local<Value> value, FontSpec* spec) {
+            Nan::HandleScope scope;
+
+            if (!value->IsObject()) {
+                Nan::ThrowTypeError("font spec must be an object");
+                return false;
+            }
+
+            Local<Object> object = value.As<Object>();
+
+            return GetString(object, keys::name, &spec->name) &&
+                   GetInt(object, keys::size, &spec->size) &&
+                   GetBoolean(object, keys::italic, &spec->italic) &&
+                   GetBoolean(object, keys::strikeOut, &spec->strikeOut) &&
+                   GetInt(object, keys::color, &spec->color) &&
+                   GetBoolean(object, keys::bold, &spec->bold) &&
+                   GetInt(object, keys::script, &spec->script) &&
+                   GetInt(object, keys::underline, &spec->underline);
+        }
+
+        bool Parse(Local<Value> value, FormatSpec* spec) {
+            Nan::HandleScope scope;
+
+            if (!value->IsObject()) {
+                Nan::ThrowTypeError("format spec must be an object");
+                return false;
+            }
+
+            Local<Object> object = value.As<Object>();
+            Local<Value> property;
+
+            if (!GetProperty(object, keys::font, &property)) return false;
+            if (!property->IsUndefined()) {
+                spec->fontObject = Font::FromJS(property);
+
+                if (!spec->fontObject && !Parse(property, &spec->font.emplace())) return false;
+            }
+
+            if (!GetProperty(object, keys::numFormat, &property)) return false;
+            if (property->IsString()) {
+                if (!GetString(object, keys::numFormat, &spec->customNumFormat)) return false;
+            } else if (!GetInt(object, keys::numFormat, &spec->numFormat)) {
+                return false;
+            }
+
+            return GetInt(object, keys::alignH, &spec->alignH) &&
+                   GetInt(object, keys::alignV, &spec->alignV) &&
+                   GetBoolean(object, keys::wrap, &spec->wrap) &&
+                   GetInt(object, keys::rotation, &spec->rotation) &&
+                   GetInt(object, keys::indent, &spec->indent) &&
+                   GetBoolean(object, keys::shrinkToFit, &spec->shrinkToFit) &&
+                   GetInt(object, keys::border, &spec->border) &&
+                   GetInt(object, keys::borderColor, &spec->borderColor) &&
+                   GetInt(object, keys::borderLeft, &spec->borderLeft) &&
+                   GetInt(object, keys::borderRight, &spec->borderRight) &&
+                   GetInt(object, keys::borderTop, &spec->borderTop) &&
+                   GetInt(object, keys::borderBottom, &spec->borderBottom) &&
+                   GetInt(object, keys::borderLeftColor, &spec->borderLeftColor) &&
+                   GetInt(object, keys::borderRightColor, &spec->borderRightColor) &&
+                   GetInt(object, keys::borderTopColor, &spec->borderTopColor) &&
+                   GetInt(object, keys::borderBottomColor, &spec->borderBottomColor) &&
+                   GetInt(object, keys::borderDiagonal, &spec->borderDiagonal) &&
+                   GetInt(object, keys::borderDiagonalColor, &spec->borderDiagonalColor) &&
+                   GetInt(object, keys::fillPattern, &spec->fillPattern) &&
+                   GetInt(object, keys::patternBackgroundColor, &spec->patternBackgroundColor) &&
+                   GetInt(object, keys::patternForegroundColor, &spec->patternForegroundColor) &&
+                   GetBoolean(object, keys::locked, &spec->locked) &&
+                   GetBoolean(object, keys::hidden, &spec->hidden);
+        }
+
+        bool Apply(const FontSpec& spec, libxl::Font* font) {
+            if (spec.name && !font->setName(spec.name->c_str())) return false;
+            if (spec.size) font->setSize(*spec.size);
+            if (spec.italic) font->setItalic(*spec.italic);
+            if (spec.strikeOut) font->setStrikeOut(*spec.strikeOut);
+            if (spec.color) font->setColor(static_cast<libxl::Color>(*spec.color));
+            if (spec.bold) font->setBold(*spec.bold);
+            if (spec.script) font->setScript(static_cast<libxl::Script>(*spec.script));
+            if (spec.underline) font->setUnderline(static_cast<libxl::Underline>(*spec.underline));
+
+            return true;
+        }
+
+        bool Apply(const FormatSpec& spec, libxl::Book* book, libxl::Format* format) {
+            if (spec.fontObject) {
+                if (!format->setFont(spec.fontObject->GetWrapped())) return false;
+            } else if (spec.font) {
+                // Derive a new font instead of modifying one that other formats may share
+                libxl::Font* font = book->addFont(format->font());
+
+                if (!font || !Apply(*spec.font, font) || !format->setFont(font)) return false;
+            }
+
+            if (spec.customNumFormat) {
+                int numFormat = book->addCustomNumFormat(spec.customNumFormat->c_str());
+                if (!numFormat) return false;
+
+                format->setNumFormat(numFormat);
+            } else if (spec.numFormat) {
+                format->setNumFormat(*spec.numFormat);
+            }
+
+            if (spec.alignH) format->setAlignH(static_cast<libxl::AlignH>(*spec.alignH));
+            if (spec.alignV) format->setAlignV(static_cast<libxl::AlignV>(*spec.alignV));
+            if (spec.wrap) format->setWrap(*spec.wrap);
+            if (spec.rotation && !format->setRotation(*spec.rotation)) return false;
+            if (spec.indent) format->setIndent(*spec.indent);
+            if (spec.shrinkToFit) format->setShrinkToFit(*spec.shrinkToFit);
+
+            // The shorthands go first so that individual sides can override them
+            if (spec.border) format->setBorder(static_cast<libxl::BorderStyle>(*spec.border));
+            if (spec.borderColor)
+                format->setBorderColor(static_cast<libxl::Color>(*spec.borderColor));
+
+            if (spec.borderLeft)
+                format->setBorderLeft(static_cast<libxl::BorderStyle>(*spec.borderLeft));
+            if (spec.borderRight)
+                format->setBorderRight(static_cast<libxl::BorderStyle>(*spec.borderRight));
+            if (spec.borderTop)
+                format->setBorderTop(static_cast<libxl::BorderStyle>(*spec.borderTop));
+            if (spec.borderBottom)
+                format->setBorderBottom(static_cast<libxl::BorderStyle>(*spec.borderBottom));
+            if (spec.borderLeftColor)
+                format->setBorderLeftColor(static_cast<libxl::Color>(*spec.borderLeftColor));
+            if (spec.borderRightColor)
+                format->setBorderRightColor(static_cast<libxl::Color>(*spec.borderRightColor));
+            if (spec.borderTopColor)
+                format->setBorderTopColor(static_cast<libxl::Color>(*spec.borderTopColor));
+            if (spec.borderBottomColor)
+                format->setBorderBottomColor(static_cast<libxl::Color>(*spec.borderBottomColor));
+            if (spec.borderDiagonal)
+                format->setBorderDiagonal(static_cast<libxl::BorderDiagonal>(*spec.borderDiagonal));
+            if (spec.borderDiagonalColor)
+                format->setBorderDiagonalColor(
+                    static_cast<libxl::Color>(*spec.borderDiagonalColor));
+
+            if (spec.fillPattern)
+                format->setFillPattern(static_cast<libxl::FillPattern>(*spec.fillPattern));
+            if (spec.patternBackgroundColor)
+                format->setPatternBackgroundColor(
+                    static_cast<libxl::Color>(*spec.patternBackgroundColor));
+            if (spec.patternForegroundColor)
+                format->setPatternForegroundColor(
+                    static_cast<libxl::Color>(*spec.patternForegroundColor));
+
+            if (spec.locked) format->setLocked(*spec.locked);
+            if (spec.hidden) format->setHidden(*spec.hidden);
+
+            return true;
+        }
+
+    }  // namespace style_spec
+}  // namespace node_libxl
@@ -0,0 +1,97 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BINDINGS_STYLE_SPEC_H
+#define BINDINGS_STYLE_SPEC_H
+
+#include <optional>
+#include <string>
+
+#include "common.h"
+
+namespace node_libxl {
+
+    class Font;
+
+    // Native form of the plain objects accepted by book.addFormat(spec) and format.set(spec).
+    // The property names are the names of the format / font getters, unset properties are
+    // left alone.
+    struct FontSpec {
+        std::optional<std::string> name;
+        std::optional<int> size;
+        std::optional<bool> italic;
+        std::optional<bool> strikeOut;
+        std::optional<int> color;
+        std::optional<bool> bold;
+        std::optional<int> script;
+        std::optional<int> underline;
+    };
+
+    struct FormatSpec {
+        // Either an existing font or the spec for a new one
+        Font* fontObject{nullptr};
+        std::optional<FontSpec> font;
+
+        std::optional<int> numFormat;
+        std::optional<std::string> customNumFormat;
+        std::optional<int> alignH;
+        std::optional<int> alignV;
+        std::optional<bool> wrap;
+        std::optional<int> rotation;
+        std::optional<int> indent;
+        std::optional<bool> shrinkToFit;
+        std::optional<int> border;
+        std::optional<int> borderColor;
+        std::optional<int> borderLeft;
+        std::optional<int> borderRight;
+        std::optional<int> borderTop;
+        std::optional<int> borderBottom;
+        std::optional<int> borderLeftColor;
+        std::optional<int> borderRightColor;
+        std::optional<int> borderTopColor;
+        std::optional<int> borderBottomColor;
+        std::optional<int> borderDiagonal;
+        std::optional<int> borderDiagonalColor;
+        std::optional<int> fillPattern;
+        std::optional<int> patternBackgroundColor;
+        std::optional<int> patternForegroundColor;
+        std::optional<bool> locked;
+        std::optional<bool> hidden;
+    };
+
+    namespace style_spec {
+
+        // Read a spec object. If the spec is malformed, a TypeError is thrown and false returned.
+        bool Parse(v8::Local<v8::Value> value, FontSpec* spec);
+        bool Parse(v8::Local<v8::Value> value, FormatSpec* spec);
+
+        // Apply a parsed spec. Returns false if libxl rejected a value, the error message is
+        // then available from the book.
+        bool Apply(const FontSpec& spec, libxl::Font* font);
+        bool Apply(const FormatSpec& spec, libxl::Book* book, libxl::Format* format);
+
+    }  // namespace style_spec
+}  // namespace node_libxl
+
+#endif  // BINDINGS_STYLE_SPEC_H
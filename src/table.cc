@@ -341,6 +341,7 @@ namespace node_libxl {
 
         t->ReadOnlyPrototype();
         constructor.Reset(Nan::GetFunction(t).ToLocalChecked());
+        functionTemplate.Reset(t);
         Nan::Set(exports, Nan::New<String>("Table").ToLocalChecked(), Nan::New(constructor));
     }
 }  // namespace node_libxl
@@ -0,0 +1,69 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "utf8_value.h"
+
+using namespace v8;
+
+namespace node_libxl {
+
+    char* EncodeUtf8(Local<Value> value, char* inlineBuffer, size_t inlineSize, size_t* length) {
+        Isolate* isolate = Isolate::GetCurrent();
+        Local<String> string;
+
+        if (!value->ToString(isolate->GetCurrentContext()).ToLocal(&string)) {
+            inlineBuffer[0] = '\0';
+            if (length) *length = 0;
+
+            return inlineBuffer;
+        }
+
+        const int flags = String::NO_NULL_TERMINATION | String::REPLACE_INVALID_UTF8;
+        int charsWritten = 0;
+        int size =
+            string->WriteUtf8(isolate, inlineBuffer, inlineSize - 1, &charsWritten, flags);
+        char* buffer = inlineBuffer;
+
+        // The inline buffer was too small: the exact size is known now, so encode once more
+        // into a buffer that fits instead of growing.
+        if (charsWritten < string->Length()) {
+            size = string->Utf8Length(isolate);
+            buffer = new char[size + 1];
+            string->WriteUtf8(isolate, buffer, size, nullptr, flags);
+        }
+
+        buffer[size] = '\0';
+        if (length) *length = size;
+
+        return buffer;
+    }
+
+    Utf8Value::Utf8Value(Local<Value> value)
+        : str(EncodeUtf8(value, inlineBuffer, inlineSize, &len)) {}
+
+    Utf8Value::~Utf8Value() {
+        if (str != inlineBuffer) delete[] str;
+    }
+
+}  // namespace node_libxl
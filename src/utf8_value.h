@@ -0,0 +1,64 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BINDINGS_UTF8_VALUE_H
+#define BINDINGS_UTF8_VALUE_H
+
+#include <v8.h>
+
+#include <cstddef>
+
+namespace node_libxl {
+
+    // Encodes value as null-terminated UTF-8 into the caller supplied buffer if it fits,
+    // falling back to a new[] allocation otherwise. Returns the encoded string, which the
+    // caller has to delete[] if it differs from inlineBuffer.
+    char* EncodeUtf8(v8::Local<v8::Value> value, char* inlineBuffer, size_t inlineSize,
+                     size_t* length = nullptr);
+
+    // Drop-in replacement for String::Utf8Value that keeps short strings on the stack.
+    class Utf8Value {
+       public:
+        explicit Utf8Value(v8::Local<v8::Value> value);
+
+        ~Utf8Value();
+
+        char* operator*() { return str; }
+        const char* operator*() const { return str; }
+        size_t length() const { return len; }
+
+       private:
+        Utf8Value(const Utf8Value&) = delete;
+        Utf8Value& operator=(const Utf8Value&) = delete;
+
+        static const size_t inlineSize = 256;
+
+        char* str;
+        size_t len;
+        char inlineBuffer[inlineSize];
+    };
+
+}  // namespace node_libxl
+
+#endif  // BINDINGS_UTF8_VALUE_H
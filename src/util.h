@@ -25,6 +25,7 @@
 #ifndef BINDINGS_UTIL
 #define BINDINGS_UTIL
 
+#include <cstdint>
 #include <cstring>
 
 #include "book.h"
@@ -78,6 +79,36 @@ namespace node_libxl {
             return !libxlBook1 || !libxlBook2 || libxlBook1 == libxlBook2;
         }
 
+        // Allocate a zero-filled typed array of type A (Uint32Array etc.) holding length
+        // elements of type E
+        template <typename A, typename E>
+        v8::Local<A> NewTypedArray(size_t length) {
+            Nan::EscapableHandleScope scope;
+
+            v8::Local<v8::ArrayBuffer> buffer =
+                v8::ArrayBuffer::New(v8::Isolate::GetCurrent(), length * sizeof(E));
+
+            return scope.Escape(A::New(buffer, 0, length));
+        }
+
+        // Copy length elements into a freshly allocated typed array of type A
+        template <typename A, typename E>
+        v8::Local<A> NewTypedArray(const E* data, size_t length) {
+            Nan::EscapableHandleScope scope;
+
+            v8::Local<A> array = NewTypedArray<A, E>(length);
+            if (length > 0) {
+                memcpy(array->Buffer()->GetBackingStore()->Data(), data, length * sizeof(E));
+            }
+
+            return scope.Escape(array);
+        }
+
+        // Nan::NewBuffer takes a uint32_t length, so check that as well as the Node limit
+        inline bool FitsBuffer(size_t size) {
+            return size <= node::Buffer::kMaxLength && size <= UINT32_MAX;
+        }
+
     }  // namespace util
 }  // namespace node_libxl
 
@@ -0,0 +1,456 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "value_format.h"
+
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __APPLE__
+#include <xlocale.h>
+#endif
+
+namespace node_libxl {
+    namespace value_format {
+
+        namespace {
+
+            // snprintf and strtod follow LC_NUMERIC, which the process may change at any time
+            // (book.setLocale does), so numbers are converted in the C locale explicitly.
+#ifdef _WIN32
+            _locale_t CLocale() {
+                static const _locale_t locale = _create_locale(LC_ALL, "C");
+                return locale;
+            }
+
+            int FormatDouble(char* buffer, size_t size, int precision, double value) {
+                return _snprintf_l(buffer, size, "%.*g", CLocale(), precision, value);
+            }
+
+            double ParseDouble(const char* text, char** end) {
+                return _strtod_l(text, end, CLocale());
+            }
+#else
+            locale_t CLocale() {
+                static const locale_t locale =
+                    newlocale(LC_ALL_MASK, "C", static_cast<locale_t>(0));
+                return locale;
+            }
+
+            int FormatDouble(char* buffer, size_t size, int precision, double value) {
+                // There is no portable snprintf_l, the thread locale is switched instead
+                locale_t previous = uselocale(CLocale());
+                int length = snprintf(buffer, size, "%.*g", precision, value);
+                uselocale(previous);
+
+                return length;
+            }
+
+            double ParseDouble(const char* text, char** end) {
+                return strtod_l(text, end, CLocale());
+            }
+#endif
+
+        }  // namespace
+
+        bool AppendNumber(std::string* out, double value) {
+            if (!std::isfinite(value)) return false;
+
+            // Shortest representation that reads back as the same double. Every double with
+            // up to 15 significant digits survives %.15g, and %g drops trailing zeros, so at
+            // most three attempts are needed. Floating point to_chars is not available on all
+            // the platforms we build for.
+            char buffer[32];
+            int length = 0;
+
+            for (int precision = 15; precision <= 17; precision++) {
+                length = FormatDouble(buffer, sizeof(buffer), precision, value);
+                if (ParseDouble(buffer, nullptr) == value) break;
+            }
+
+            out->append(buffer, length);
+            return true;
+        }
+
+        bool AppendIsoDate(std::string* out, libxl::Book* book, double value) {
+            int year, month, day, hour, minute, second, msecond;
+
+            if (!book->dateUnpack(value, &year, &month, &day, &hour, &minute, &second,
+                                  &msecond)) {
+                return false;
+            }
+
+            char buffer[32];
+            int length;
+
+            if (hour == 0 && minute == 0 && second == 0 && msecond == 0) {
+                length = snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", year, month, day);
+            } else if (msecond == 0) {
+                length = snprintf(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02d", year,
+                                  month, day, hour, minute, second);
+            } else {
+                length = snprintf(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02d.%03d",
+                                  year, month, day, hour, minute, second, msecond);
+            }
+
+            out->append(buffer, length);
+            return true;
+        }
+
+        namespace {
+
+            // Parse exactly count digits at text[*pos]
+            bool ParseDigits(const char* text, size_t length, size_t* pos, int count,
+                             int* value) {
+                if (*pos + count > length) return false;
+
+                *value = 0;
+
+                for (int i = 0; i < count; i++) {
+                    char c = text[(*pos)++];
+                    if (c < '0' || c > '9') return false;
+
+                    *value = *value * 10 + (c - '0');
+                }
+
+                return true;
+            }
+
+            int DaysInMonth(int year, int month) {
+                static const int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+                bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+
+                return month == 2 && leap ? 29 : days[month - 1];
+            }
+
+            // Days since 1970-01-01 of a proleptic Gregorian date (H. Hinnant's days_from_civil)
+            int64_t DaysFromCivil(int64_t year, unsigned month, unsigned day) {
+                year -= month <= 2;
+
+                int64_t era = (year >= 0 ? year : year - 399) / 400;
+                unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+                unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+                unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+
+                return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+            }
+
+            // Inverse of DaysFromCivil
+            void CivilFromDays(int64_t days, int* year, int* month, int* day) {
+                days += 719468;
+
+                int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+                unsigned dayOfEra = static_cast<unsigned>(days - era * 146097);
+                unsigned yearOfEra =
+                    (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+                unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+                unsigned shiftedMonth = (5 * dayOfYear + 2) / 153;
+
+                *day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+                *month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+                *year = static_cast<int>(yearOfEra + era * 400) + (*month <= 2);
+            }
+
+        }  // namespace
+
+        bool ToEpochMs(libxl::Book* book, double value, double* ms) {
+            int year, month, day, hour, minute, second, msecond;
+
+            if (!book->dateUnpack(value, &year, &month, &day, &hour, &minute, &second,
+                                  &msecond)) {
+                return false;
+            }
+
+            *ms = static_cast<double>(DaysFromCivil(year, month, day)) * 86400000. +
+                  ((hour * 60. + minute) * 60. + second) * 1000. + msecond;
+
+            return true;
+        }
+
+        bool FromEpochMs(libxl::Book* book, double ms, double* value) {
+            // Beyond the range of a JS Date (also false for NaN), which keeps the integer
+            // arithmetic below from overflowing
+            if (!(std::fabs(ms) <= 8.64e15)) return false;
+
+            int64_t total = std::llround(ms);
+            int64_t days = total >= 0 ? total / 86400000 : (total - 86399999) / 86400000;
+            int64_t time = total - days * 86400000;
+            int year, month, day;
+
+            CivilFromDays(days, &year, &month, &day);
+
+            // Dates libxl can not represent
+            if (year < (book->isDate1904() ? 1904 : 1900) || year > 9999) return false;
+
+            double serial = book->datePack(year, month, day, static_cast<int>(time / 3600000),
+                                           static_cast<int>(time / 60000 % 60),
+                                           static_cast<int>(time / 1000 % 60),
+                                           static_cast<int>(time % 1000));
+
+            if (!std::isfinite(serial) || serial < 0) return false;
+
+            *value = serial;
+            return true;
+        }
+
+        namespace {
+
+            const double msPerDay = 86400000.;
+
+            // Serial date of 1970-01-01 and of the day after 9999-12-31
+            struct DateSystem {
+                double epoch;
+                double end;
+                // Serials below this need libxl: 1900-03-01 comes after Excel's 1900-02-29
+                double first;
+            };
+
+            DateSystem GetDateSystem(libxl::Book* book) {
+                bool date1904 = book->isDate1904();
+
+                if (date1904) return {24107., 2957004., 0.};
+                return {25569., 2958466., 61.};
+            }
+
+        }  // namespace
+
+        void ToEpochMs(libxl::Book* book, const double* values, double* out, size_t count) {
+            DateSystem system = GetDateSystem(book);
+
+            for (size_t i = 0; i < count; i++) {
+                double value = values[i];
+
+                // Also false for NaN
+                if (value >= system.first && value < system.end) {
+                    out[i] = std::round((value - system.epoch) * msPerDay);
+                } else if (!ToEpochMs(book, value, &out[i])) {
+                    out[i] = std::nan("");
+                }
+            }
+        }
+
+        void FromEpochMs(libxl::Book* book, const double* values, double* out, size_t count) {
+            DateSystem system = GetDateSystem(book);
+
+            for (size_t i = 0; i < count; i++) {
+                double value = std::round(values[i]) / msPerDay + system.epoch;
+
+                if (value >= system.first && value < system.end) {
+                    out[i] = value;
+                } else if (!FromEpochMs(book, values[i], &out[i])) {
+                    out[i] = std::nan("");
+                }
+            }
+        }
+
+        const char* ErrorText(int error) {
+            switch (error) {
+                case libxl::ERRORTYPE_NULL:
+                    return "#NULL!";
+                case libxl::ERRORTYPE_DIV_0:
+                    return "#DIV/0!";
+                case libxl::ERRORTYPE_VALUE:
+                    return "#VALUE!";
+                case libxl::ERRORTYPE_REF:
+                    return "#REF!";
+                case libxl::ERRORTYPE_NAME:
+                    return "#NAME?";
+                case libxl::ERRORTYPE_NUM:
+                    return "#NUM!";
+                case libxl::ERRORTYPE_NA:
+                    return "#N/A";
+                default:
+                    return "";
+            }
+        }
+
+        void AppendJsonString(std::string* out, const char* text, size_t length) {
+            static const char hex[] = "0123456789abcdef";
+
+            out->push_back('"');
+
+            for (size_t i = 0; i < length; i++) {
+                unsigned char c = text[i];
+
+                switch (c) {
+                    case '"':
+                        out->append("\\\"");
+                        break;
+                    case '\\':
+                        out->append("\\\\");
+                        break;
+                    case '\n':
+                        out->append("\\n");
+                        break;
+                    case '\r':
+                        out->append("\\r");
+                        break;
+                    case '\t':
+                        out->append("\\t");
+                        break;
+                    default:
+                        if (c < 0x20) {
+                            out->append("\\u00");
+                            out->push_back(hex[c >> 4]);
+                            out->push_back(hex[c & 0xf]);
+                        } else {
+                            out->push_back(c);
+                        }
+                }
+            }
+
+            out->push_back('"');
+        }
+
+        bool AppendJsonValue(std::string* out, libxl::Book* book, libxl::Sheet* sheet, int row,
+                             int col, bool isoDates, bool* written) {
+            libxl::CellType type = sheet->cellType(row, col);
+            *written = true;
+
+            switch (type) {
+                case libxl::CELLTYPE_NUMBER: {
+                    double value = sheet->readNum(row, col), ms;
+
+                    if (sheet->isDate(row, col)) {
+                        if (isoDates) {
+                            std::string date;
+
+                            if (AppendIsoDate(&date, book, value)) {
+                                AppendJsonString(out, date.data(), date.size());
+                                return true;
+                            }
+                        } else if (ToEpochMs(book, value, &ms)) {
+                            value = ms;
+                        }
+                    }
+
+                    if (!AppendNumber(out, value)) out->append("null");
+                    return true;
+                }
+
+                case libxl::CELLTYPE_STRING: {
+                    const char* value = sheet->readStr(row, col);
+                    if (!value) return false;
+
+                    AppendJsonString(out, value, strlen(value));
+                    return true;
+                }
+
+                case libxl::CELLTYPE_BOOLEAN:
+                    out->append(sheet->readBool(row, col) ? "true" : "false");
+                    return true;
+
+                case libxl::CELLTYPE_ERROR: {
+                    const char* text = ErrorText(sheet->readError(row, col));
+
+                    AppendJsonString(out, text, strlen(text));
+                    return true;
+                }
+
+                default:
+                    *written = false;
+                    return true;
+            }
+        }
+
+        bool ParseNumber(const char* text, size_t length, double* value) {
+            if (length == 0) return false;
+
+            // strtod would also accept "inf", "nan", hex floats and leading blanks
+            char first = text[0] == '-' && length > 1 ? text[1] : text[0];
+            if ((first < '0' || first > '9') && first != '.') return false;
+
+            for (size_t i = 0; i < length; i++) {
+                if (!strchr("0123456789+-.eE", text[i]) || text[i] == 0) return false;
+            }
+
+            // The text is not NUL terminated
+            char buffer[64];
+            std::string copy;
+            const char* terminated = buffer;
+
+            if (length < sizeof(buffer)) {
+                memcpy(buffer, text, length);
+                buffer[length] = 0;
+            } else {
+                copy.assign(text, length);
+                terminated = copy.c_str();
+            }
+
+            char* end;
+            *value = ParseDouble(terminated, &end);
+
+            return end == terminated + length && std::isfinite(*value);
+        }
+
+        bool ParseIsoDate(const char* text, size_t length, libxl::Book* book, double* value,
+                          bool* hasTime) {
+            int year, month, day, hour = 0, minute = 0, second = 0, msecond = 0;
+            size_t pos = 0;
+
+            if (!ParseDigits(text, length, &pos, 4, &year) || pos >= length ||
+                text[pos++] != '-' || !ParseDigits(text, length, &pos, 2, &month) ||
+                pos >= length || text[pos++] != '-' || !ParseDigits(text, length, &pos, 2, &day)) {
+                return false;
+            }
+
+            *hasTime = pos < length;
+
+            if (*hasTime) {
+                if (text[pos] != 'T' && text[pos] != ' ') return false;
+                pos++;
+
+                if (!ParseDigits(text, length, &pos, 2, &hour) || pos >= length ||
+                    text[pos++] != ':' || !ParseDigits(text, length, &pos, 2, &minute)) {
+                    return false;
+                }
+
+                if (pos < length && (text[pos++] != ':' ||
+                                     !ParseDigits(text, length, &pos, 2, &second))) {
+                    return false;
+                }
+
+                if (pos < length && (text[pos++] != '.' ||
+                                     !ParseDigits(text, length, &pos, 3, &msecond))) {
+                    return false;
+                }
+
+                if (pos < length) return false;
+            }
+
+            if (month < 1 || month > 12 || day < 1 || day > DaysInMonth(year, month) ||
+                hour > 23 || minute > 59 || second > 59) {
+                return false;
+            }
+
+            *value = book->datePack(year, month, day, hour, minute, second, msecond);
+            return true;
+        }
+
+    }  // namespace value_format
+}  // namespace node_libxl
@@ -0,0 +1,79 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Christian Speckner <cnspeckn@googlemail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BINDINGS_VALUE_FORMAT_H
+#define BINDINGS_VALUE_FORMAT_H
+
+#include <string>
+
+#include "common.h"
+
+namespace node_libxl {
+    namespace value_format {
+
+        // Shortest representation that parses back to the same double. Returns false (and
+        // appends nothing) for NaN and infinities.
+        bool AppendNumber(std::string* out, double value);
+
+        // ISO 8601: YYYY-MM-DD if there is no time of day, YYYY-MM-DDTHH:MM:SS[.mmm]
+        // otherwise. The 1900 / 1904 date system of the book is honored. Returns false if
+        // the value can not be converted.
+        bool AppendIsoDate(std::string* out, libxl::Book* book, double value);
+
+        // Milliseconds since the Unix epoch. Returns false if the value can not be converted.
+        bool ToEpochMs(libxl::Book* book, double value, double* ms);
+        bool FromEpochMs(libxl::Book* book, double ms, double* value);
+
+        // Convert count values at once; values and out may be the same array. Dates between
+        // March 1900 and the end of 9999 are converted arithmetically (rounded to whole
+        // milliseconds), the rest goes through libxl. Values that can not be converted become
+        // NaN.
+        void ToEpochMs(libxl::Book* book, const double* values, double* out, size_t count);
+        void FromEpochMs(libxl::Book* book, const double* values, double* out, size_t count);
+
+        // Excel's spelling of an error value (#DIV/0!, #N/A, ...)
+        const char* ErrorText(int error);
+
+        // Quoted and escaped JSON string. UTF-8 is passed through unchanged.
+        void AppendJsonString(std::string* out, const char* text, size_t length);
+
+        // JSON value of a cell: numbers, strings, booleans, error text and dates as ISO 8601
+        // strings or milliseconds since the epoch. Blank cells append nothing and set written
+        // to false. Returns false on a libxl error.
+        bool AppendJsonValue(std::string* out, libxl::Book* book, libxl::Sheet* sheet, int row,
+                             int col, bool isoDates, bool* written);
+
+        // Parse a plain decimal number (optionally with exponent) spanning the whole input.
+        // Hex, infinities and NaN are rejected.
+        bool ParseNumber(const char* text, size_t length, double* value);
+
+        // Parse YYYY-MM-DD with an optional time of day (T or blank separated, HH:MM[:SS[.mmm]])
+        // into a serial date of the book. hasTime is set if a time of day was present.
+        bool ParseIsoDate(const char* text, size_t length, libxl::Book* book, double* value,
+                          bool* hasTime);
+
+    }  // namespace value_format
+}  // namespace node_libxl
+
+#endif  // BINDINGS_VALUE_FORMAT_H
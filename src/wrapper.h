@@ -42,6 +42,7 @@ namespace node_libxl {
 
        protected:
         static Nan::Persistent<v8::Function> constructor;
+        static Nan::Persistent<v8::FunctionTemplate> functionTemplate;
         T* wrapped;
 
        private:
@@ -54,15 +55,15 @@ namespace node_libxl {
     template <typename T, typename U>
     Nan::Persistent<v8::Function> Wrapper<T, U>::constructor;
 
+    template <typename T, typename U>
+    Nan::Persistent<v8::FunctionTemplate> Wrapper<T, U>::functionTemplate;
+
     template <typename T, typename U>
     bool Wrapper<T, U>::InstanceOf(v8::Local<v8::Value> object) {
         Nan::HandleScope scope;
 
-        return object->IsObject() &&
-               object.As<v8::Object>()->GetPrototype()->StrictEquals(
-                   Nan::Get(Nan::New(constructor),
-                            Nan::New<v8::String>("prototype").ToLocalChecked())
-                       .ToLocalChecked());
+        // Checks the template the object was instantiated from, no prototype lookup involved
+        return object->IsObject() && Nan::New(functionTemplate)->HasInstance(object);
     }
 
     template <typename T, typename U>
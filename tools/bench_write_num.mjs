@@ -0,0 +1,41 @@
+// Micro benchmark for the per call overhead of the bindings: writeNum with a format
+// argument unwraps two objects (sheet and format) per call.
+//
+// usage: node tools/bench_write_num.mjs [iterations]
+
+import { createRequire } from 'module';
+
+const require = createRequire(import.meta.url);
+const xl = require('../lib/libxl');
+
+const iterations = parseInt(process.argv[2] ?? '1000000', 10);
+const rows = 1000;
+
+const book = new xl.Book(xl.BOOK_TYPE_XLSX);
+const sheet = book.addSheet('bench');
+const format = book.addFormat();
+
+function run(withFormat) {
+    const start = process.hrtime.bigint();
+
+    for (let i = 0; i < iterations; i++) {
+        if (withFormat) {
+            sheet.writeNum(i % rows, 0, i, format);
+        } else {
+            sheet.writeNum(i % rows, 0, i);
+        }
+    }
+
+    return Number(process.hrtime.bigint() - start) / iterations;
+}
+
+// Warm up
+run(true);
+run(false);
+
+const withFormat = run(true);
+const withoutFormat = run(false);
+
+console.log(`writeNum with format:    ${withFormat.toFixed(1)} ns/call`);
+console.log(`writeNum without format: ${withoutFormat.toFixed(1)} ns/call`);
+console.log(`format argument overhead: ${(withFormat - withoutFormat).toFixed(1)} ns/call`);